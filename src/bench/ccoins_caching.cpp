@@ -9,6 +9,7 @@
 #include <key.h>
 #include <policy/policy.h>
 #include <primitives/transaction.h>
+#include <random.h>
 #include <script/script.h>
 #include <script/signingprovider.h>
 #include <test/util/transaction_utils.h>
@@ -54,4 +55,29 @@ static void CCoinsCaching(benchmark::Bench& bench)
     });
 }
 
+//! Look up random coins in a cache filled with a million of them, as during
+//! block validation with a large -dbcache.
+static void CCoinsCachingLarge(benchmark::Bench& bench)
+{
+    constexpr size_t NUM_COINS{1'000'000};
+    FastRandomContext rng{/*fDeterministic=*/true};
+    CCoinsViewCache coins{&CoinsViewEmpty::Get(), /*deterministic=*/true};
+    std::vector<COutPoint> outpoints;
+    outpoints.reserve(NUM_COINS);
+    for (size_t i{0}; i < NUM_COINS; ++i) {
+        const COutPoint& outpoint{outpoints.emplace_back(Txid::FromUint256(rng.rand256()), uint32_t(rng.randbits(2)))};
+        coins.EmplaceCoinInternalDANGER(COutPoint{outpoint}, Coin{CTxOut{1, CScript{} << OP_TRUE}, 1, false});
+    }
+
+    size_t i{0};
+    bench.batch(1000).unit("lookup").run([&] {
+        for (int j{0}; j < 1000; ++j) {
+            assert(!coins.AccessCoin(outpoints[rng.randrange(NUM_COINS)]).IsSpent());
+            // Every fourth lookup misses, like a coin that is only in the database.
+            if (++i % 4 == 0) assert(!coins.HaveCoin(COutPoint{Txid::FromUint256(rng.rand256()), 0}));
+        }
+    });
+}
+
 BENCHMARK(CCoinsCaching);
+BENCHMARK(CCoinsCachingLarge);
@@ -5,6 +5,7 @@
 #include <bench/bench.h>
 #include <crypto/chacha20.h>
 #include <crypto/chacha20poly1305.h>
+#include <tinyformat.h>
 // IWYU incorrectly suggests removing this header.
 // See https://github.com/include-what-you-use/include-what-you-use/issues/2014.
 #include <util/byte_units.h> // IWYU pragma: keep
@@ -58,6 +59,13 @@ static void CHACHA20_1MB(benchmark::Bench& bench)
     CHACHA20(bench, BUFFER_SIZE_LARGE);
 }
 
+static void CHACHA20_1MB_STANDARD(benchmark::Bench& bench)
+{
+    bench.name(strprintf("%s using the '%s' ChaCha20 implementation", __func__, ChaCha20AutoDetect(chacha20_implementation::STANDARD)));
+    CHACHA20(bench, BUFFER_SIZE_LARGE);
+    ChaCha20AutoDetect();
+}
+
 static void FSCHACHA20POLY1305_64BYTES(benchmark::Bench& bench)
 {
     FSCHACHA20POLY1305(bench, BUFFER_SIZE_TINY);
@@ -76,6 +84,7 @@ static void FSCHACHA20POLY1305_1MB(benchmark::Bench& bench)
 BENCHMARK(CHACHA20_64BYTES);
 BENCHMARK(CHACHA20_256BYTES);
 BENCHMARK(CHACHA20_1MB);
+BENCHMARK(CHACHA20_1MB_STANDARD);
 BENCHMARK(FSCHACHA20POLY1305_64BYTES);
 BENCHMARK(FSCHACHA20POLY1305_256BYTES);
 BENCHMARK(FSCHACHA20POLY1305_1MB);
@@ -17,6 +17,7 @@
 #include <script/script.h>
 #include <sync.h>
 #include <test/util/setup_common.h>
+#include <util/chaintype.h>
 #include <util/check.h>
 #include <validation.h>
 
@@ -138,6 +139,29 @@ static void ConnectBlockAllEcdsa(benchmark::Bench& bench)
     BenchmarkConnectBlock(bench, keys, outputs, *test_setup);
 }
 
+/*
+ * Connects the same all-Schnorr block with -par=<n>, so that n - 1 threads of the shared
+ * validation thread pool verify scripts and prefetch prevouts alongside the main thread.
+ * Comparing the runs shows how block connection scales with the number of cores.
+ */
+static void ConnectBlockScaling(benchmark::Bench& bench, const char* par_arg, const char* prevoutfetch_arg)
+{
+    const auto test_setup{MakeNoLogFileContext<TestChain100Setup>(ChainType::REGTEST, {.extra_args{par_arg, prevoutfetch_arg}})};
+    auto [keys, outputs]{CreateKeysAndOutputs(test_setup->coinbaseKey, /*num_schnorr=*/5, /*num_ecdsa=*/0)};
+    BenchmarkConnectBlock(bench, keys, outputs, *test_setup);
+}
+
+static void ConnectBlockScaling1Thread(benchmark::Bench& bench) { ConnectBlockScaling(bench, "-par=1", "-prevoutfetchthreads=0"); }
+static void ConnectBlockScaling2Threads(benchmark::Bench& bench) { ConnectBlockScaling(bench, "-par=2", "-prevoutfetchthreads=1"); }
+static void ConnectBlockScaling4Threads(benchmark::Bench& bench) { ConnectBlockScaling(bench, "-par=4", "-prevoutfetchthreads=3"); }
+static void ConnectBlockScaling8Threads(benchmark::Bench& bench) { ConnectBlockScaling(bench, "-par=8", "-prevoutfetchthreads=7"); }
+static void ConnectBlockScaling16Threads(benchmark::Bench& bench) { ConnectBlockScaling(bench, "-par=16", "-prevoutfetchthreads=15"); }
+
 BENCHMARK(ConnectBlockAllSchnorr);
 BENCHMARK(ConnectBlockMixedEcdsaSchnorr);
 BENCHMARK(ConnectBlockAllEcdsa);
+BENCHMARK(ConnectBlockScaling1Thread);
+BENCHMARK(ConnectBlockScaling2Threads);
+BENCHMARK(ConnectBlockScaling4Threads);
+BENCHMARK(ConnectBlockScaling8Threads);
+BENCHMARK(ConnectBlockScaling16Threads);
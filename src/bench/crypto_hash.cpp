@@ -181,6 +181,31 @@ static void SHA256D64_1024_SHANI(benchmark::Bench& bench)
     SHA256AutoDetect();
 }
 
+static void SHA256DMulti_Txs(benchmark::Bench& bench, sha256_implementation::UseImplementation use_implementation, const char* name)
+{
+    bench.name(strprintf("%s using the '%s' SHA256 implementation", name, SHA256AutoDetect(use_implementation)));
+    // Transaction-sized messages of varying length.
+    FastRandomContext rng{/*fDeterministic=*/true};
+    std::vector<std::vector<unsigned char>> msgs(1024);
+    std::vector<std::span<const unsigned char>> inputs;
+    size_t bytes{0};
+    for (auto& msg : msgs) {
+        msg = rng.randbytes<unsigned char>(150 + rng.randrange(450));
+        inputs.emplace_back(msg);
+        bytes += msg.size();
+    }
+    std::vector<unsigned char> out(32 * msgs.size());
+    bench.batch(bytes).unit("byte").run([&] {
+        SHA256DMulti(out.data(), inputs);
+    });
+    SHA256AutoDetect();
+}
+
+static void SHA256DMulti_Txs_STANDARD(benchmark::Bench& bench) { SHA256DMulti_Txs(bench, sha256_implementation::STANDARD, __func__); }
+static void SHA256DMulti_Txs_SSE4(benchmark::Bench& bench) { SHA256DMulti_Txs(bench, sha256_implementation::USE_SSE4, __func__); }
+static void SHA256DMulti_Txs_AVX2(benchmark::Bench& bench) { SHA256DMulti_Txs(bench, sha256_implementation::USE_SSE4_AND_AVX2, __func__); }
+static void SHA256DMulti_Txs_SHANI(benchmark::Bench& bench) { SHA256DMulti_Txs(bench, sha256_implementation::USE_SSE4_AND_SHANI, __func__); }
+
 static void SHA512(benchmark::Bench& bench)
 {
     uint8_t hash[CSHA512::OUTPUT_SIZE];
@@ -324,6 +349,10 @@ BENCHMARK(SHA256D64_1024_STANDARD);
 BENCHMARK(SHA256D64_1024_SSE4);
 BENCHMARK(SHA256D64_1024_AVX2);
 BENCHMARK(SHA256D64_1024_SHANI);
+BENCHMARK(SHA256DMulti_Txs_STANDARD);
+BENCHMARK(SHA256DMulti_Txs_SSE4);
+BENCHMARK(SHA256DMulti_Txs_AVX2);
+BENCHMARK(SHA256DMulti_Txs_SHANI);
 
 BENCHMARK(MuHash);
 BENCHMARK(MuHashMul);
@@ -0,0 +1,80 @@
+// Copyright (c) The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or https://www.opensource.org/licenses/mit-license.php.
+
+#include <addresstype.h>
+#include <bench/bench.h>
+#include <blockfilter.h>
+#include <index/base.h>
+#include <index/blockfilterindex.h>
+#include <index/coinstatsindex.h>
+#include <index/txindex.h>
+#include <index/txospenderindex.h>
+#include <interfaces/chain.h>
+#include <primitives/transaction.h>
+#include <pubkey.h>
+#include <script/script.h>
+#include <sync.h>
+#include <test/util/setup_common.h>
+#include <test/util/time.h>
+#include <util/strencodings.h>
+#include <validation.h>
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace util::hex_literals;
+
+//! Sync all four indexes from scratch, either one after another or at the same
+//! time, in which case they share block reads.
+static void MultiIndexSync(benchmark::Bench& bench, bool concurrent)
+{
+    const auto test_setup = MakeNoLogFileContext<TestChain100Setup>();
+
+    // Create more blocks
+    const int CHAIN_SIZE = 600;
+    CPubKey pubkey{"02ed26169896db86ced4cbb7b3ecef9859b5952825adbeab998fb5b307e54949c9"_hex_u8};
+    CScript script = GetScriptForDestination(WitnessV0KeyHash(pubkey));
+    std::vector<CMutableTransaction> noTxns;
+    for (int i = 0; i < CHAIN_SIZE - 100; i++) {
+        test_setup->CreateAndProcessBlock(noTxns, script);
+        test_setup->m_clock += 1s;
+    }
+    assert(WITH_LOCK(::cs_main, return test_setup->m_node.chainman->ActiveHeight() == CHAIN_SIZE));
+    // Flush, so the indexes commit their state like on a node that was restarted.
+    test_setup->m_node.chainman->ActiveChainstate().ForceFlushStateToDisk();
+
+    bench.minEpochIterations(5).run([&] {
+        auto& node{test_setup->m_node};
+        std::vector<std::unique_ptr<BaseIndex>> indexes;
+        indexes.emplace_back(std::make_unique<TxIndex>(interfaces::MakeChain(node), /*n_cache_size=*/0, /*f_memory=*/false, /*f_wipe=*/true));
+        indexes.emplace_back(std::make_unique<BlockFilterIndex>(interfaces::MakeChain(node), BlockFilterType::BASIC, /*n_cache_size=*/0, /*f_memory=*/false, /*f_wipe=*/true));
+        indexes.emplace_back(std::make_unique<CoinStatsIndex>(interfaces::MakeChain(node), /*n_cache_size=*/0, /*f_memory=*/false, /*f_wipe=*/true));
+        indexes.emplace_back(std::make_unique<TxoSpenderIndex>(interfaces::MakeChain(node), /*n_cache_size=*/0, /*f_memory=*/false, /*f_wipe=*/true));
+        for (auto& index : indexes) assert(index->Init());
+
+        if (concurrent) {
+            for (auto& index : indexes) assert(index->StartBackgroundSync());
+            for (auto& index : indexes) {
+                while (!index->GetSummary().synced) std::this_thread::sleep_for(1ms);
+            }
+        } else {
+            for (auto& index : indexes) index->Sync();
+        }
+
+        // Shutdown sequence (c.f. Shutdown() in init.cpp)
+        for (auto& index : indexes) {
+            assert(index->GetSummary().best_block_height == CHAIN_SIZE);
+            index->Interrupt();
+            index->Stop();
+        }
+    });
+}
+
+static void MultiIndexSyncSequential(benchmark::Bench& bench) { MultiIndexSync(bench, /*concurrent=*/false); }
+static void MultiIndexSyncConcurrent(benchmark::Bench& bench) { MultiIndexSync(bench, /*concurrent=*/true); }
+
+BENCHMARK(MultiIndexSyncSequential);
+BENCHMARK(MultiIndexSyncConcurrent);
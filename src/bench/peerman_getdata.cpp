@@ -0,0 +1,120 @@
+// Copyright (c) The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <net.h>
+#include <net_processing.h>
+#include <netmessagemaker.h>
+#include <protocol.h>
+#include <random.h>
+#include <sync.h>
+#include <test/util/net.h>
+#include <test/util/setup_common.h>
+#include <validation.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+//! Drop the messages queued for the node, as if they were sent, and return whether a block
+//! was among them.
+static bool FlushSentBlock(CNode& node)
+{
+    LOCK(node.cs_vSend);
+    node.fPauseSend = false;
+    bool sent_block{std::ranges::any_of(node.vSendMsg, [](const auto& msg) { return msg.m_type == NetMsgType::BLOCK; })};
+    node.vSendMsg.clear();
+    node.m_send_memusage = 0;
+    while (true) {
+        const auto& [to_send, _more, msg_type] = node.m_transport->GetBytesToSend(false);
+        if (to_send.empty()) break;
+        sent_block |= msg_type == NetMsgType::BLOCK;
+        node.m_transport->MarkBytesSent(to_send.size());
+    }
+    return sent_block;
+}
+
+/**
+ * Drive many peers through the message handler: a few of them request historical blocks,
+ * the others only send pings. One iteration delivers a message to every peer and runs the
+ * message handler until all of them have been answered.
+ */
+static void ProcessMessagesBlockServing(benchmark::Bench& bench, bool async_block_reads)
+{
+    constexpr int NUM_SERVING_PEERS{8};
+    constexpr int NUM_RELAY_PEERS{64};
+
+    std::vector<const char*> extra_args;
+    if (async_block_reads) extra_args.push_back("-asyncblockreads");
+    const auto testing_setup{MakeNoLogFileContext<TestChain100Setup>(ChainType::REGTEST, {.extra_args = extra_args})};
+    auto& connman{static_cast<ConnmanTestMsg&>(*testing_setup->m_node.connman)};
+    auto& peerman{*testing_setup->m_node.peerman};
+    const auto& chainman{*testing_setup->m_node.chainman};
+
+    std::vector<uint256> block_hashes;
+    {
+        LOCK(cs_main);
+        for (const CBlockIndex* index{chainman.ActiveTip()}; index; index = index->pprev) {
+            block_hashes.push_back(index->GetBlockHash());
+        }
+    }
+
+    LOCK(NetEventsInterface::g_msgproc_mutex);
+
+    std::vector<CNode*> nodes;
+    for (NodeId id{0}; id < NUM_SERVING_PEERS + NUM_RELAY_PEERS; ++id) {
+        nodes.push_back(new CNode{id,
+                                  /*sock=*/nullptr,
+                                  CAddress{},
+                                  /*nKeyedNetGroupIn=*/0,
+                                  /*nLocalHostNonceIn=*/0,
+                                  CAddress{},
+                                  /*addrNameIn=*/"",
+                                  ConnectionType::INBOUND,
+                                  /*inbound_onion=*/false,
+                                  /*network_key=*/0});
+        connman.Handshake(*nodes.back(),
+                          /*successfully_connected=*/true,
+                          /*remote_services=*/ServiceFlags(NODE_NETWORK | NODE_WITNESS),
+                          /*local_services=*/ServiceFlags(NODE_NETWORK | NODE_WITNESS),
+                          /*version=*/PROTOCOL_VERSION,
+                          /*relay_txs=*/true);
+        FlushSentBlock(*nodes.back());
+        connman.AddTestNode(*nodes.back());
+    }
+    const std::span serving_peers{std::span{nodes}.first(NUM_SERVING_PEERS)};
+    const std::span relay_peers{std::span{nodes}.subspan(NUM_SERVING_PEERS)};
+
+    FastRandomContext rng{/*fDeterministic=*/true};
+    bench.run([&] {
+        for (CNode* node : serving_peers) {
+            const CInv inv{MSG_WITNESS_BLOCK, block_hashes[rng.randrange(block_hashes.size())]};
+            (void)connman.ReceiveMsgFrom(*node, NetMsg::Make(NetMsgType::GETDATA, std::vector{inv}));
+        }
+        for (CNode* node : relay_peers) {
+            (void)connman.ReceiveMsgFrom(*node, NetMsg::Make(NetMsgType::PING, rng.rand64()));
+        }
+
+        // Like CConnman::ThreadMessageHandler, but without waiting for new messages.
+        int blocks_left{NUM_SERVING_PEERS};
+        bool more_work{true};
+        while (more_work || blocks_left > 0) {
+            more_work = false;
+            for (CNode* node : nodes) {
+                more_work |= connman.ProcessMessagesOnce(*node);
+                peerman.SendMessages(*node);
+                if (FlushSentBlock(*node)) --blocks_left;
+            }
+        }
+    });
+
+    connman.StopNodes();
+}
+
+static void ProcessMessagesBlockServingSync(benchmark::Bench& bench) { ProcessMessagesBlockServing(bench, /*async_block_reads=*/false); }
+static void ProcessMessagesBlockServingAsync(benchmark::Bench& bench) { ProcessMessagesBlockServing(bench, /*async_block_reads=*/true); }
+
+BENCHMARK(ProcessMessagesBlockServingSync);
+BENCHMARK(ProcessMessagesBlockServingAsync);
@@ -19,6 +19,7 @@
 #include <memory>
 #include <optional>
 #include <span>
+#include <vector>
 
 static CBlock CreateTestBlock()
 {
@@ -64,6 +65,25 @@ static void ReadRawBlockBench(benchmark::Bench& bench)
     });
 }
 
+#ifndef WIN32
+static void MapRawBlockBench(benchmark::Bench& bench)
+{
+    const auto testing_setup{MakeNoLogFileContext<const TestingSetup>(ChainType::MAIN)};
+    auto& blockman{testing_setup->m_node.chainman->m_blockman};
+    const auto pos{WITH_LOCK(::cs_main, return blockman.WriteBlock(CreateTestBlock(), 413'567))};
+    bench.run([&] {
+        // Like serving the block to a peer, which copies it into the message.
+        const auto res{blockman.MapRawBlock(pos)};
+        assert(res);
+        std::vector<std::byte> data(res->size());
+        res->CopyTo(data);
+    });
+}
+#endif // WIN32
+
 BENCHMARK(WriteBlockBench);
 BENCHMARK(ReadBlockBench);
 BENCHMARK(ReadRawBlockBench);
+#ifndef WIN32
+BENCHMARK(MapRawBlockBench);
+#endif // WIN32
@@ -0,0 +1,68 @@
+// Copyright (c) The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <compat/compat.h>
+#include <util/check.h>
+#include <util/fs_helpers.h>
+#include <util/sock.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#ifndef WIN32
+#include <sys/socket.h>
+
+//! Connected sockets of which only one end is waited for and nothing is ever sent, like
+//! the many idle peers of a public node.
+struct IdleSockets {
+    std::vector<std::shared_ptr<const Sock>> watched;
+    std::vector<std::unique_ptr<Sock>> peers;
+
+    explicit IdleSockets(int num_sockets)
+    {
+        // Both ends of each pair and some spare descriptors for the rest of the process.
+        num_sockets = std::min(num_sockets, (RaiseFileDescriptorLimit(2 * num_sockets + 64) - 64) / 2);
+        for (int i{0}; i < num_sockets; ++i) {
+            int fds[2];
+            Assert(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+            watched.push_back(std::make_shared<const Sock>(fds[0]));
+            peers.push_back(std::make_unique<Sock>(fds[1]));
+        }
+    }
+
+    //! Same as the socket handler loops, which rebuild the map on every iteration.
+    Sock::EventsPerSock Events() const
+    {
+        Sock::EventsPerSock events_per_sock;
+        for (const auto& sock : watched) {
+            events_per_sock.emplace(sock, Sock::Events{Sock::RecvEvent});
+        }
+        return events_per_sock;
+    }
+};
+
+static void WaitManyIdleSockets(benchmark::Bench& bench)
+{
+    const IdleSockets socks{1000};
+    bench.run([&] {
+        auto events_per_sock{socks.Events()};
+        Assert(socks.watched.front()->WaitMany(0ms, events_per_sock));
+    });
+}
+
+static void SockPollerIdleSockets(benchmark::Bench& bench)
+{
+    const IdleSockets socks{1000};
+    SockPoller poller;
+    bench.run([&] {
+        auto events_per_sock{socks.Events()};
+        Assert(poller.WaitMany(0ms, events_per_sock));
+    });
+}
+
+BENCHMARK(WaitManyIdleSockets);
+BENCHMARK(SockPollerIdleSockets);
+#endif // WIN32
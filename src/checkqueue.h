@@ -8,13 +8,28 @@
 #include <sync.h>
 #include <tinyformat.h>
 #include <util/log.h>
-#include <util/threadnames.h>
+#include <util/threadpool.h>
 
 #include <algorithm>
+#include <concepts>
+#include <condition_variable>
+#include <functional>
 #include <iterator>
+#include <memory>
 #include <optional>
 #include <vector>
 
+/**
+ * A verification that can defer part of its work to a batch of type T::Batch,
+ * which is shared by the checks a worker processes together. Deferred work must
+ * only be able to turn success into failure, and is completed by Batch::Verify().
+ */
+template <typename T>
+concept BatchableCheck = std::default_initializable<typename T::Batch> && requires(T check, typename T::Batch batch) {
+    check(batch);
+    { batch.Verify() } -> std::same_as<bool>;
+};
+
 /**
  * Queue for verifications that have to be performed.
   * The verifications are represented by a type T, which must provide an
@@ -24,9 +39,11 @@
   * return std::nullopt, or one of the other results otherwise.
   *
   * One thread (the master) is assumed to push batches of verifications
-  * onto the queue, where they are processed by N-1 worker threads. When
-  * the master is done adding work, it temporarily joins the worker pool
-  * as an N'th worker, until all jobs are done.
+  * onto the queue, where they are processed by up to N-1 helper tasks running
+  * on a ThreadPool, which may be shared with other users. Helpers are
+  * submitted as work is added and return their thread to the pool once the
+  * queue runs empty. When the master is done adding work, it temporarily
+  * joins the helpers as an N'th worker, until all jobs are done.
   *
   */
 template <typename T, typename R = std::remove_cvref_t<decltype(std::declval<T>()().value())>>
@@ -36,20 +53,23 @@ private:
     //! Mutex to protect the inner state
     Mutex m_mutex;
 
-    //! Worker threads block on this when out of work
-    std::condition_variable m_worker_cv;
-
     //! Master thread blocks on this when out of work
     std::condition_variable m_master_cv;
 
+    //! The destructor blocks on this until all helpers have returned
+    std::condition_variable m_helpers_cv;
+
     //! The queue of elements to be processed.
     //! As the order of booleans doesn't matter, it is used as a LIFO (stack)
     std::vector<T> queue GUARDED_BY(m_mutex);
 
-    //! The number of workers (including the master) that are idle.
-    int nIdle GUARDED_BY(m_mutex){0};
+    //! The number of helpers submitted to the thread pool that haven't started yet.
+    int m_helpers_pending GUARDED_BY(m_mutex){0};
 
-    //! The total number of workers (including the master).
+    //! The number of helpers submitted to the thread pool that haven't returned yet.
+    int m_helpers_active GUARDED_BY(m_mutex){0};
+
+    //! The total number of workers (including the master) currently processing checks.
     int nTotal GUARDED_BY(m_mutex){0};
 
     //! The temporary evaluation result.
@@ -65,14 +85,38 @@ private:
     //! The maximum number of elements to be processed in one batch
     const unsigned int nBatchSize;
 
-    std::vector<std::thread> m_worker_threads;
+    //! The maximum number of helpers running concurrently on the thread pool.
+    const int m_max_helpers;
+
+    //! Pool the helpers run on. Non-null.
+    std::shared_ptr<ThreadPool> m_thread_pool;
+
     bool m_request_stop GUARDED_BY(m_mutex){false};
 
+    //! Account for a helper returning its thread to the pool.
+    std::optional<R> LeaveHelper() EXCLUSIVE_LOCKS_REQUIRED(m_mutex)
+    {
+        nTotal--;
+        if (--m_helpers_active == 0) m_helpers_cv.notify_all();
+        return std::nullopt;
+    }
+
+    //! Submit helpers to the thread pool. If the pool refuses them, the master processes the checks on its own.
+    void SpawnHelpers(int count) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        std::vector<std::function<void()>> helpers(count, [this] { Loop(false /* helper */); });
+        if (!m_thread_pool->Submit(std::move(helpers))) {
+            LOCK(m_mutex);
+            m_helpers_pending -= count;
+            m_helpers_active -= count;
+            if (m_helpers_active == 0) m_helpers_cv.notify_all();
+        }
+    }
+
     /// \anchor checkqueue
     /** Internal function that does bulk of the verification work. If fMaster, return the final result. */
     std::optional<R> Loop(bool fMaster) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
     {
-        std::condition_variable& cond = fMaster ? m_master_cv : m_worker_cv;
         std::vector<T> vChecks;
         vChecks.reserve(nBatchSize);
         unsigned int nNow = 0;
@@ -94,10 +138,15 @@ private:
                 } else {
                     // first iteration
                     nTotal++;
+                    if (!fMaster) m_helpers_pending--;
                 }
                 // logically, the do loop starts here
                 while (queue.empty() && !m_request_stop) {
-                    if (fMaster && nTodo == 0) {
+                    if (!fMaster) {
+                        // Helpers don't idle here; hand the thread back to the pool until more work is added.
+                        return LeaveHelper();
+                    }
+                    if (nTodo == 0) {
                         nTotal--;
                         std::optional<R> to_return = std::move(m_result);
                         // reset the status for new work later
@@ -105,21 +154,19 @@ private:
                         // return the current status
                         return to_return;
                     }
-                    nIdle++;
-                    cond.wait(lock); // wait
-                    nIdle--;
+                    m_master_cv.wait(lock); // wait
                 }
                 if (m_request_stop) {
                     // return value does not matter, because m_request_stop is only set in the destructor.
-                    return std::nullopt;
+                    return fMaster ? std::nullopt : LeaveHelper();
                 }
 
                 // Decide how many work units to process now.
                 // * Do not try to do everything at once, but aim for increasingly smaller batches so
                 //   all workers finish approximately simultaneously.
-                // * Try to account for idle jobs which will instantly start helping.
+                // * Try to account for pending helpers which will instantly start helping.
                 // * Don't do batches smaller than 1 (duh), or larger than nBatchSize.
-                nNow = std::max(1U, std::min(nBatchSize, (unsigned int)queue.size() / (nTotal + nIdle + 1)));
+                nNow = std::max(1U, std::min(nBatchSize, (unsigned int)queue.size() / (nTotal + m_helpers_pending + 1)));
                 auto start_it = queue.end() - nNow;
                 vChecks.assign(std::make_move_iterator(start_it), std::make_move_iterator(queue.end()));
                 queue.erase(start_it, queue.end());
@@ -128,6 +175,15 @@ private:
             }
             // execute work
             if (do_work) {
+                if constexpr (BatchableCheck<T>) {
+                    typename T::Batch batch;
+                    for (T& check : vChecks) {
+                        local_result = check(batch);
+                        if (local_result.has_value()) break;
+                    }
+                    // If deferred work failed, run the checks on their own below to find out which one did.
+                    if (local_result.has_value() || batch.Verify()) vChecks.clear();
+                }
                 for (T& check : vChecks) {
                     local_result = check();
                     if (local_result.has_value()) break;
@@ -141,22 +197,26 @@ public:
     //! Mutex to ensure only one concurrent CCheckQueueControl
     Mutex m_control_mutex;
 
-    //! Create a new check queue
-    explicit CCheckQueue(unsigned int batch_size, int worker_threads_num)
-        : nBatchSize(batch_size)
+    /**
+     * Create a new check queue.
+     *
+     * @param batch_size         The maximum number of checks processed by a worker in one go.
+     * @param worker_threads_num The maximum number of helpers running besides the master.
+     * @param thread_pool        A started pool to run helpers on, possibly shared with other users.
+     *                           If null, a dedicated pool with worker_threads_num threads is created.
+     */
+    explicit CCheckQueue(unsigned int batch_size, int worker_threads_num, std::shared_ptr<ThreadPool> thread_pool = nullptr)
+        : nBatchSize(batch_size), m_max_helpers(std::max(worker_threads_num, 0)), m_thread_pool(std::move(thread_pool))
     {
-        LogInfo("Script verification uses %d additional threads", worker_threads_num);
-        m_worker_threads.reserve(worker_threads_num);
-        for (int n = 0; n < worker_threads_num; ++n) {
-            m_worker_threads.emplace_back([this, n]() {
-                util::ThreadRename(strprintf("scriptch.%02i", n));
-                Loop(false /* worker thread */);
-            });
+        LogInfo("Script verification uses %d additional threads", m_max_helpers);
+        if (!m_thread_pool) {
+            m_thread_pool = std::make_shared<ThreadPool>("scriptch");
+            if (m_max_helpers > 0) m_thread_pool->Start(m_max_helpers);
         }
     }
 
-    // Since this class manages its own resources, which is a thread
-    // pool `m_worker_threads`, copy and move operations are not appropriate.
+    // Since this class hands out references to itself to the helpers running
+    // on `m_thread_pool`, copy and move operations are not appropriate.
     CCheckQueue(const CCheckQueue&) = delete;
     CCheckQueue& operator=(const CCheckQueue&) = delete;
     CCheckQueue(CCheckQueue&&) = delete;
@@ -176,29 +236,29 @@ public:
             return;
         }
 
+        int num_helpers;
         {
             LOCK(m_mutex);
             queue.insert(queue.end(), std::make_move_iterator(vChecks.begin()), std::make_move_iterator(vChecks.end()));
             nTodo += vChecks.size();
+            // Request more helpers, but never more than there are new checks to share.
+            num_helpers = std::min<int>(m_max_helpers - m_helpers_active, vChecks.size());
+            m_helpers_pending += num_helpers;
+            m_helpers_active += num_helpers;
         }
 
-        if (vChecks.size() == 1) {
-            m_worker_cv.notify_one();
-        } else {
-            m_worker_cv.notify_all();
-        }
+        if (num_helpers > 0) SpawnHelpers(num_helpers);
     }
 
     ~CCheckQueue()
     {
-        WITH_LOCK(m_mutex, m_request_stop = true);
-        m_worker_cv.notify_all();
-        for (std::thread& t : m_worker_threads) {
-            t.join();
-        }
+        WAIT_LOCK(m_mutex, lock);
+        m_request_stop = true;
+        // Helpers still queued on or running in the pool reference this object.
+        m_helpers_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return m_helpers_active == 0; });
     }
 
-    bool HasThreads() const { return !m_worker_threads.empty(); }
+    bool HasThreads() const { return m_max_helpers > 0; }
 };
 
 /**
@@ -12,6 +12,7 @@
 #include <util/threadpool.h>
 #include <util/trace.h>
 
+#include <algorithm>
 #include <ranges>
 #include <unordered_set>
 
@@ -34,14 +35,45 @@ CoinsViewEmpty& CoinsViewEmpty::Get()
 
 std::optional<Coin> CCoinsViewCache::PeekCoin(const COutPoint& outpoint) const
 {
-    if (auto it{cacheCoins.find(outpoint)}; it != cacheCoins.end()) {
-        return it->second.coin.IsSpent() ? std::nullopt : std::optional{it->second.coin};
+    {
+        const auto lock{LockForRead()};
+        if (auto it{cacheCoins.find(outpoint)}; it != cacheCoins.end()) {
+            m_peek_hits.fetch_add(1, std::memory_order_relaxed);
+            return it->second.coin.IsSpent() ? std::nullopt : std::optional{it->second.coin};
+        }
     }
+    m_peek_misses.fetch_add(1, std::memory_order_relaxed);
+    // Entries missing from the cache are not modified by flushing it, so the
+    // base can be read without holding the lock.
     return base->PeekCoin(outpoint);
 }
 
-CCoinsViewCache::CCoinsViewCache(CCoinsView* in_base, bool deterministic) :
-    CCoinsViewBacked(in_base), m_deterministic(deterministic),
+std::vector<std::optional<Coin>> CCoinsViewCache::PeekCoins(std::span<const COutPoint> outpoints) const
+{
+    std::vector<std::optional<Coin>> coins(outpoints.size());
+    std::vector<COutPoint> missing;
+    std::vector<size_t> missing_indexes;
+    {
+        const auto lock{LockForRead()};
+        for (size_t i{0}; i < outpoints.size(); ++i) {
+            if (auto it{cacheCoins.find(outpoints[i])}; it != cacheCoins.end()) {
+                if (!it->second.coin.IsSpent()) coins[i] = it->second.coin;
+            } else {
+                missing.push_back(outpoints[i]);
+                missing_indexes.push_back(i);
+            }
+        }
+    }
+    m_peek_hits.fetch_add(outpoints.size() - missing.size(), std::memory_order_relaxed);
+    m_peek_misses.fetch_add(missing.size(), std::memory_order_relaxed);
+    if (missing.empty()) return coins;
+    auto base_coins{base->PeekCoins(missing)};
+    for (size_t i{0}; i < missing.size(); ++i) coins[missing_indexes[i]] = std::move(base_coins[i]);
+    return coins;
+}
+
+CCoinsViewCache::CCoinsViewCache(CCoinsView* in_base, bool deterministic, bool concurrent_reads) :
+    CCoinsViewBacked(in_base), m_deterministic(deterministic), m_concurrent_reads(concurrent_reads),
     cacheCoins(0, SaltedCoinsCacheHasher{/*deterministic=*/deterministic}, CCoinsMap::key_equal{}, &m_cache_coins_memory_resource)
 {
     m_sentinel.second.SelfRef(m_sentinel);
@@ -51,6 +83,14 @@ size_t CCoinsViewCache::DynamicMemoryUsage() const {
     return memusage::DynamicUsage(cacheCoins) + cachedCoinsUsage;
 }
 
+CoinsCacheStats CCoinsViewCache::GetStats() const
+{
+    return {
+        .hits = m_hits + m_peek_hits.load(std::memory_order_relaxed),
+        .misses = m_misses + m_peek_misses.load(std::memory_order_relaxed),
+    };
+}
+
 std::optional<Coin> CCoinsViewCache::FetchCoinFromBase(const COutPoint& outpoint) const
 {
     return base->GetCoin(outpoint);
@@ -58,7 +98,10 @@ std::optional<Coin> CCoinsViewCache::FetchCoinFromBase(const COutPoint& outpoint
 
 CCoinsMap::iterator CCoinsViewCache::FetchCoin(const COutPoint &outpoint) const {
     const auto [ret, inserted] = cacheCoins.try_emplace(outpoint);
-    if (inserted) {
+    if (!inserted) {
+        ++m_hits;
+    } else {
+        ++m_misses;
         if (auto coin{FetchCoinFromBase(outpoint)}) {
             ret->second.coin = std::move(*coin);
             cachedCoinsUsage += ret->second.coin.DynamicMemoryUsage();
@@ -73,6 +116,7 @@ CCoinsMap::iterator CCoinsViewCache::FetchCoin(const COutPoint &outpoint) const
 
 std::optional<Coin> CCoinsViewCache::GetCoin(const COutPoint& outpoint) const
 {
+    const auto lock{LockForWrite()};
     if (auto it{FetchCoin(outpoint)}; it != cacheCoins.end() && !it->second.coin.IsSpent()) return it->second.coin;
     return std::nullopt;
 }
@@ -80,9 +124,10 @@ std::optional<Coin> CCoinsViewCache::GetCoin(const COutPoint& outpoint) const
 void CCoinsViewCache::AddCoin(const COutPoint &outpoint, Coin&& coin, bool possible_overwrite) {
     assert(!coin.IsSpent());
     if (coin.out.scriptPubKey.IsUnspendable()) return;
+    const auto lock{LockForWrite()};
     CCoinsMap::iterator it;
     bool inserted;
-    std::tie(it, inserted) = cacheCoins.emplace(std::piecewise_construct, std::forward_as_tuple(outpoint), std::tuple<>());
+    std::tie(it, inserted) = cacheCoins.try_emplace(outpoint);
     bool fresh = false;
     if (!possible_overwrite) {
         if (!it->second.coin.IsSpent()) {
@@ -122,6 +167,7 @@ void CCoinsViewCache::AddCoin(const COutPoint &outpoint, Coin&& coin, bool possi
 
 void CCoinsViewCache::EmplaceCoinInternalDANGER(const COutPoint& outpoint, Coin&& coin) {
     const auto mem_usage{coin.DynamicMemoryUsage()};
+    const auto lock{LockForWrite()};
     auto [it, inserted] = cacheCoins.try_emplace(outpoint, std::move(coin));
     if (inserted) {
         CCoinsCacheEntry::SetDirty(*it, m_sentinel);
@@ -142,6 +188,7 @@ void AddCoins(CCoinsViewCache& cache, const CTransaction &tx, int nHeight, bool
 }
 
 bool CCoinsViewCache::SpendCoin(const COutPoint &outpoint, Coin* moveout) {
+    const auto lock{LockForWrite()};
     CCoinsMap::iterator it = FetchCoin(outpoint);
     if (it == cacheCoins.end()) return false;
     Assume(TrySub(m_dirty_count, it->second.IsDirty()));
@@ -168,6 +215,7 @@ bool CCoinsViewCache::SpendCoin(const COutPoint &outpoint, Coin* moveout) {
 static const Coin coinEmpty;
 
 const Coin& CCoinsViewCache::AccessCoin(const COutPoint &outpoint) const {
+    const auto lock{LockForWrite()};
     CCoinsMap::const_iterator it = FetchCoin(outpoint);
     if (it == cacheCoins.end()) {
         return coinEmpty;
@@ -178,16 +226,20 @@ const Coin& CCoinsViewCache::AccessCoin(const COutPoint &outpoint) const {
 
 bool CCoinsViewCache::HaveCoin(const COutPoint& outpoint) const
 {
+    const auto lock{LockForWrite()};
     CCoinsMap::const_iterator it = FetchCoin(outpoint);
     return (it != cacheCoins.end() && !it->second.coin.IsSpent());
 }
 
 bool CCoinsViewCache::HaveCoinInCache(const COutPoint &outpoint) const {
+    const auto lock{LockForRead()};
     CCoinsMap::const_iterator it = cacheCoins.find(outpoint);
     return (it != cacheCoins.end() && !it->second.coin.IsSpent());
 }
 
 uint256 CCoinsViewCache::GetBestBlock() const {
+    if (const auto lock{LockForRead()}; !m_block_hash.IsNull()) return m_block_hash;
+    const auto lock{LockForWrite()};
     if (m_block_hash.IsNull())
         m_block_hash = base->GetBestBlock();
     return m_block_hash;
@@ -195,11 +247,13 @@ uint256 CCoinsViewCache::GetBestBlock() const {
 
 void CCoinsViewCache::SetBestBlock(const uint256& in_block_hash)
 {
+    const auto lock{LockForWrite()};
     m_block_hash = in_block_hash;
 }
 
 void CCoinsViewCache::BatchWrite(CoinsViewCacheCursor& cursor, const uint256& in_block_hash)
 {
+    const auto lock{LockForWrite()};
     for (auto it{cursor.Begin()}; it != cursor.End(); it = cursor.NextAndMaybeErase(*it)) {
         if (!it->second.IsDirty()) { // TODO a cursor can only contain dirty entries
             continue;
@@ -266,23 +320,25 @@ void CCoinsViewCache::BatchWrite(CoinsViewCacheCursor& cursor, const uint256& in
             }
         }
     }
-    SetBestBlock(in_block_hash);
+    m_block_hash = in_block_hash;
 }
 
 void CCoinsViewCache::Flush(bool reallocate_cache)
 {
+    const auto lock{LockForWrite()};
     auto cursor{CoinsViewCacheCursor(m_dirty_count, m_sentinel, cacheCoins, /*will_erase=*/true)};
     base->BatchWrite(cursor, m_block_hash);
     Assume(m_dirty_count == 0);
     cacheCoins.clear();
     if (reallocate_cache) {
-        ReallocateCache();
+        ReallocateCacheLocked();
     }
     cachedCoinsUsage = 0;
 }
 
 void CCoinsViewCache::Sync()
 {
+    const auto lock{LockForWrite()};
     auto cursor{CoinsViewCacheCursor(m_dirty_count, m_sentinel, cacheCoins, /*will_erase=*/false)};
     base->BatchWrite(cursor, m_block_hash);
     Assume(m_dirty_count == 0);
@@ -294,14 +350,16 @@ void CCoinsViewCache::Sync()
 
 void CCoinsViewCache::Reset() noexcept
 {
+    const auto lock{LockForWrite()};
     cacheCoins.clear();
     cachedCoinsUsage = 0;
     m_dirty_count = 0;
-    SetBestBlock(uint256::ZERO);
+    m_block_hash = uint256::ZERO;
 }
 
 void CCoinsViewCache::Uncache(const COutPoint& hash)
 {
+    const auto lock{LockForWrite()};
     CCoinsMap::iterator it = cacheCoins.find(hash);
     if (it != cacheCoins.end() && !it->second.IsDirty()) {
         Assume(TrySub(cachedCoinsUsage, it->second.coin.DynamicMemoryUsage()));
@@ -332,6 +390,12 @@ bool CCoinsViewCache::HaveInputs(const CTransaction& tx) const
 }
 
 void CCoinsViewCache::ReallocateCache()
+{
+    const auto lock{LockForWrite()};
+    ReallocateCacheLocked();
+}
+
+void CCoinsViewCache::ReallocateCacheLocked()
 {
     // Cache should be empty when we're calling this.
     assert(cacheCoins.size() == 0);
@@ -379,7 +443,7 @@ CCoinsViewCache::ResetGuard CoinsViewOverlay::StartFetching(const CBlock& block
     Assert(m_inputs.empty());
     Assert(m_input_head.load(std::memory_order_relaxed) == 0);
     Assert(m_input_tail == 0);
-    if (const auto workers_count{m_thread_pool->WorkersCount()}; workers_count > 0) {
+    if (const auto workers_count{std::min(m_thread_pool->WorkersCount(), m_max_fetch_tasks)}; workers_count > 0) {
         // Loop through the block inputs and set their prevouts in the queue.
         // Filter inputs that spend outputs created earlier in the same block. These outputs will be created
         // directly in the cache from the tx that creates them, so they will not be requested from a base view.
@@ -394,7 +458,7 @@ CCoinsViewCache::ResetGuard CoinsViewOverlay::StartFetching(const CBlock& block
         // Only submit tasks if we have something to fetch.
         if (m_inputs.size()) {
             std::vector<std::function<void()>> tasks(workers_count, [this] {
-                while (ProcessInput()) {}
+                while (ProcessInputs()) {}
             });
             if (auto futures{m_thread_pool->Submit(std::move(tasks))}) {
                 m_futures = std::move(*futures);
@@ -457,3 +521,8 @@ std::optional<Coin> CCoinsViewErrorCatcher::PeekCoin(const COutPoint& outpoint)
 {
     return ExecuteBackedWrapper<std::optional<Coin>>([&]() { return CCoinsViewBacked::PeekCoin(outpoint); }, m_err_callbacks);
 }
+
+std::vector<std::optional<Coin>> CCoinsViewErrorCatcher::PeekCoins(std::span<const COutPoint> outpoints) const
+{
+    return ExecuteBackedWrapper<std::vector<std::optional<Coin>>>([&]() { return base->PeekCoins(outpoints); }, m_err_callbacks);
+}
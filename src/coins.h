@@ -17,6 +17,7 @@
 #include <support/allocators/pool.h>
 #include <uint256.h>
 #include <util/check.h>
+#include <util/flatnodemap.h>
 #include <util/log.h>
 #include <util/overflow.h>
 
@@ -26,9 +27,11 @@
 #include <atomic>
 #include <functional>
 #include <future>
+#include <limits>
 #include <memory>
 #include <optional>
-#include <unordered_map>
+#include <shared_mutex>
+#include <span>
 #include <utility>
 #include <vector>
 
@@ -233,8 +236,8 @@ public:
  * Hash values are process-local and must not be persisted, serialized, or compared across
  * processes.
  *
- * Having the hash noexcept lets libstdc++ recalculate it during rehash instead of storing it in
- * each node.
+ * The hash must be noexcept, as CCoinsMap recalculates it for every entry when its index grows
+ * instead of storing it.
  */
 class SaltedCoinsCacheHasher
 {
@@ -257,19 +260,17 @@ public:
 };
 
 /**
- * PoolAllocator's MAX_BLOCK_SIZE_BYTES parameter here uses sizeof the data, and adds the size
- * of 4 pointers. We do not know the exact node size used in the std::unordered_node implementation
- * because it is implementation defined. Most implementations have an overhead of 1 or 2 pointers,
- * so nodes can be connected in a linked list, and in some cases the hash value is stored as well.
- * Using an additional sizeof(void*)*4 for MAX_BLOCK_SIZE_BYTES should thus be sufficient so that
- * all implementations can allocate the nodes from the PoolAllocator.
+ * Map from outpoints to cache entries. Its open-addressing index keeps tags and pointers
+ * of 7 entries per cache line, while the entries themselves are allocated from a
+ * PoolResource and never move, so the flagged entry list can point into them. As
+ * FlatNodeMap nodes hold nothing but the entry, MAX_BLOCK_SIZE_BYTES is exactly the size
+ * of a CoinsCachePair.
  */
-using CCoinsMap = std::unordered_map<COutPoint,
-                                     CCoinsCacheEntry,
-                                     SaltedCoinsCacheHasher,
-                                     std::equal_to<COutPoint>,
-                                     PoolAllocator<CoinsCachePair,
-                                                   sizeof(CoinsCachePair) + sizeof(void*) * 4>>;
+using CCoinsMap = FlatNodeMap<COutPoint,
+                              CCoinsCacheEntry,
+                              SaltedCoinsCacheHasher,
+                              std::equal_to<COutPoint>,
+                              PoolAllocator<CoinsCachePair, sizeof(CoinsCachePair)>>;
 
 using CCoinsMapMemoryResource = CCoinsMap::allocator_type::ResourceType;
 
@@ -342,6 +343,8 @@ struct CoinsViewCacheCursor
     }
 
     inline bool WillErase(CoinsCachePair& current) const noexcept { return m_will_erase || current.second.coin.IsSpent(); }
+    //! Whether the caller will erase the whole map after BatchWrite returns.
+    bool WillEraseAll() const noexcept { return m_will_erase; }
     size_t GetDirtyCount() const noexcept { return m_dirty_count; }
     size_t GetTotalCount() const noexcept { return m_map.size(); }
 private:
@@ -366,6 +369,16 @@ public:
     //! Does not populate the cache. Use GetCoin() to cache the result.
     virtual std::optional<Coin> PeekCoin(const COutPoint& outpoint) const = 0;
 
+    //! PeekCoin() for several outpoints, returning the results in the same order.
+    //! Views backed by a database override this to read all of them at once.
+    virtual std::vector<std::optional<Coin>> PeekCoins(std::span<const COutPoint> outpoints) const
+    {
+        std::vector<std::optional<Coin>> coins;
+        coins.reserve(outpoints.size());
+        for (const COutPoint& outpoint : outpoints) coins.push_back(PeekCoin(outpoint));
+        return coins;
+    }
+
     //! Just check whether a given outpoint is unspent.
     //! May populate the cache. Use PeekCoin() to perform a non-caching lookup.
     virtual bool HaveCoin(const COutPoint& outpoint) const = 0;
@@ -432,11 +445,42 @@ public:
 };
 
 
+//! Cumulative lookup counters of a CCoinsViewCache.
+struct CoinsCacheStats {
+    //! Lookups answered from the cache, and lookups that went to the base view.
+    uint64_t hits{0};
+    uint64_t misses{0};
+    //! Of the misses of a CoinsViewOverlay, those answered by a prefetched
+    //! input, and those that read the base view directly.
+    uint64_t prefetch_hits{0};
+    uint64_t prefetch_misses{0};
+};
+
 /** CCoinsView that adds a memory cache for transactions to another CCoinsView */
 class CCoinsViewCache : public CCoinsViewBacked
 {
 private:
     const bool m_deterministic;
+    const bool m_concurrent_reads;
+
+    /**
+     * Excludes readers calling PeekCoin(), PeekCoins(), HaveCoinInCache() or GetBestBlock()
+     * from other threads while the cache is modified. Only taken if concurrent
+     * reads were enabled at construction. Modifications themselves must still
+     * be serialized by the caller.
+     */
+    mutable std::shared_mutex m_cache_mutex;
+
+    [[nodiscard]] std::unique_lock<std::shared_mutex> LockForWrite() const
+    {
+        return m_concurrent_reads ? std::unique_lock{m_cache_mutex} : std::unique_lock<std::shared_mutex>{};
+    }
+    [[nodiscard]] std::shared_lock<std::shared_mutex> LockForRead() const
+    {
+        return m_concurrent_reads ? std::shared_lock{m_cache_mutex} : std::shared_lock<std::shared_mutex>{};
+    }
+
+    void ReallocateCacheLocked();
 
 protected:
     /**
@@ -454,6 +498,13 @@ protected:
     /* Running count of dirty Coin cache entries. */
     mutable size_t m_dirty_count{0};
 
+    /* Lookup counters of FetchCoin(), whose callers are serialized. */
+    mutable uint64_t m_hits{0};
+    mutable uint64_t m_misses{0};
+    /* Lookup counters of PeekCoin() and PeekCoins(), which may run concurrently. */
+    mutable std::atomic<uint64_t> m_peek_hits{0};
+    mutable std::atomic<uint64_t> m_peek_misses{0};
+
     /**
      * Discard all modifications made to this cache without flushing to the base view.
      * This can be used to efficiently reuse a cache instance across multiple operations.
@@ -464,7 +515,13 @@ protected:
     virtual std::optional<Coin> FetchCoinFromBase(const COutPoint& outpoint) const;
 
 public:
-    CCoinsViewCache(CCoinsView* in_base, bool deterministic = false);
+    /**
+     * If concurrent_reads is set, PeekCoin(), PeekCoins(), HaveCoinInCache() and
+     * GetBestBlock() may be called from other threads while the cache is being
+     * modified. This requires a base view whose PeekCoin() and PeekCoins() are safe
+     * to call concurrently as well.
+     */
+    CCoinsViewCache(CCoinsView* in_base, bool deterministic = false, bool concurrent_reads = false);
 
     /**
      * By deleting the copy constructor, we prevent accidentally using it when one intends to create a cache on top of a base cache.
@@ -474,6 +531,7 @@ public:
     // Standard CCoinsView methods
     std::optional<Coin> GetCoin(const COutPoint& outpoint) const override;
     std::optional<Coin> PeekCoin(const COutPoint& outpoint) const override;
+    std::vector<std::optional<Coin>> PeekCoins(std::span<const COutPoint> outpoints) const override;
     bool HaveCoin(const COutPoint& outpoint) const override;
     uint256 GetBestBlock() const override;
     void SetBestBlock(const uint256& block_hash);
@@ -552,6 +610,9 @@ public:
     //! Calculate the size of the cache (in bytes)
     size_t DynamicMemoryUsage() const;
 
+    //! Lookup counters since this cache was created.
+    virtual CoinsCacheStats GetStats() const;
+
     //! Check whether all prevouts of the transaction are present in the UTXO set represented by this view
     bool HaveInputs(const CTransaction& tx) const;
 
@@ -604,15 +665,16 @@ private:
  * objects. StartFetching then submits worker tasks to a ThreadPool and keeps the returned futures alive until fetching
  * is stopped.
  *
- * ProcessInput() atomically fetches and increments m_input_head, so each thread can only access a single element of the
- * m_inputs vector at a time. Workers race to claim inputs, so they may fetch elements in any order. If the fetched
- * index is greater than or equal to the size of m_inputs, no more inputs can be fetched and false is returned.
+ * ProcessInputs() atomically fetches and advances m_input_head by FETCH_BATCH_SIZE, so each thread claims a small run
+ * of consecutive m_inputs elements at a time. Workers race to claim batches, so they may fetch elements in any order.
+ * If the fetched index is greater than or equal to the size of m_inputs, no more inputs can be fetched and false is
+ * returned.
  *
- * The worker claims the InputToFetch at this index, fetches the coin from the base cache and moves it into the
- * InputToFetch object. The ready flag is then set with a release memory order. This allows the ready flag to be
+ * The worker reads the coins of its batch with a single base->PeekCoins() call, which lets the database look them up
+ * together, and moves each into its InputToFetch object. Each ready flag is then set with a release memory order. This allows the ready flag to be
  * used as a memory fence, guaranteeing the coin being written to the object will have happened before another
  * thread tests the flag with an acquire memory order.
- * This assumes all base->PeekCoin() paths are safe for concurrent readers and do not mutate lower cache layers.
+ * This assumes all base->PeekCoins() paths are safe for concurrent readers and do not mutate lower cache layers.
  *
  * When a coin is requested from the cache on the main thread and is not already in cacheCoins map, FetchCoinFromBase
  * checks whether the next unconsumed entry in m_inputs has the requested outpoint. On a match, m_input_tail is advanced
@@ -681,22 +743,32 @@ private:
     //! Must only be mutated when m_futures is empty. Elements may be mutated when m_futures is not empty.
     std::vector<InputToFetch> m_inputs{};
 
+    //! Number of inputs a worker claims at once and reads with a single base->PeekCoins() call.
+    static constexpr uint32_t FETCH_BATCH_SIZE{8};
+
     /**
-     * Claim and fetch the next input in the queue.
+     * Claim and fetch the next batch of inputs in the queue.
      *
-     * @return true if an input prevout was fetched
+     * @return true if input prevouts were fetched
      * @return false if there are no more input prevouts in the queue to fetch
      */
-    bool ProcessInput() noexcept
+    bool ProcessInputs() noexcept
     {
-        const auto i{m_input_head.fetch_add(1, std::memory_order_relaxed)};
-        if (i >= m_inputs.size()) return false;
-
-        auto& input{m_inputs[i]};
-        input.coin = base->PeekCoin(input.outpoint);
-        // Use release so writing coin above happens before the main thread acquires.
-        Assert(!input.ready.test_and_set(std::memory_order_release));
-        input.ready.notify_one();
+        const size_t begin{m_input_head.fetch_add(FETCH_BATCH_SIZE, std::memory_order_relaxed)};
+        if (begin >= m_inputs.size()) return false;
+        const size_t end{std::min(begin + FETCH_BATCH_SIZE, m_inputs.size())};
+
+        std::vector<COutPoint> outpoints;
+        outpoints.reserve(end - begin);
+        for (size_t i{begin}; i < end; ++i) outpoints.push_back(m_inputs[i].outpoint);
+        auto coins{base->PeekCoins(outpoints)};
+        for (size_t i{begin}; i < end; ++i) {
+            auto& input{m_inputs[i]};
+            input.coin = std::move(coins[i - begin]);
+            // Use release so writing coin above happens before the main thread acquires.
+            Assert(!input.ready.test_and_set(std::memory_order_release));
+            input.ready.notify_one();
+        }
         return true;
     }
 
@@ -727,6 +799,7 @@ private:
         if (m_input_tail < m_inputs.size() && m_inputs[m_input_tail].outpoint == outpoint) {
             // We advance the tail since the input is cached and not accessed through this method again.
             auto& input{m_inputs[m_input_tail++]};
+            ++m_prefetch_hits;
             // Wait until the coin is ready to be read. We need acquire so we match the worker thread's release.
             input.ready.wait(/*old=*/false, std::memory_order_acquire);
             // We can move the coin since we won't access this input again.
@@ -734,11 +807,18 @@ private:
         }
 
         // We will only get here for BIP30 checks, an invalid block, or if the threadpool has not been started.
+        ++m_prefetch_misses;
         return base->PeekCoin(outpoint);
     }
 
-    //! Non-null. May have zero workers when input fetching is disabled.
+    //! Base lookups answered by a prefetched input, and those that were not. Only the main thread updates these.
+    mutable uint64_t m_prefetch_hits{0};
+    mutable uint64_t m_prefetch_misses{0};
+
+    //! Non-null. May have zero workers when input fetching is disabled. May be shared with other users.
     std::shared_ptr<ThreadPool> m_thread_pool;
+    //! Upper bound on the number of fetch tasks submitted to m_thread_pool per block.
+    const size_t m_max_fetch_tasks;
     std::vector<std::future<void>> m_futures{};
 
 protected:
@@ -750,8 +830,9 @@ protected:
 
 public:
     explicit CoinsViewOverlay(CCoinsView* in_base, std::shared_ptr<ThreadPool> thread_pool,
-                              bool deterministic = false) noexcept
-        : CCoinsViewCache{in_base, deterministic}, m_thread_pool{std::move(thread_pool)}
+                              bool deterministic = false,
+                              size_t max_fetch_tasks = std::numeric_limits<size_t>::max()) noexcept
+        : CCoinsViewCache{in_base, deterministic}, m_thread_pool{std::move(thread_pool)}, m_max_fetch_tasks{max_fetch_tasks}
     {
         Assert(m_thread_pool);
     }
@@ -770,6 +851,14 @@ public:
         CCoinsViewCache::Flush(reallocate_cache);
     }
 
+    CoinsCacheStats GetStats() const override
+    {
+        auto stats{CCoinsViewCache::GetStats()};
+        stats.prefetch_hits = m_prefetch_hits;
+        stats.prefetch_misses = m_prefetch_misses;
+        return stats;
+    }
+
     //! Verify that all parallel fetched input prevouts have been consumed.
     bool AllInputsConsumed() const noexcept { return m_input_tail == m_inputs.size(); }
 };
@@ -807,6 +896,7 @@ public:
     std::optional<Coin> GetCoin(const COutPoint& outpoint) const override;
     bool HaveCoin(const COutPoint& outpoint) const override;
     std::optional<Coin> PeekCoin(const COutPoint& outpoint) const override;
+    std::vector<std::optional<Coin>> PeekCoins(std::span<const COutPoint> outpoints) const override;
 
 private:
     /** A list of callbacks to execute upon leveldb read error. */
@@ -103,6 +103,8 @@ typedef SSIZE_T ssize_t;
 // __APPLE__ poll is broke https://github.com/bitcoin/bitcoin/pull/14336#issuecomment-437384408
 #if defined(__linux__)
 #define USE_POLL
+// epoll(7) keeps the set of watched sockets in the kernel across calls, see SockPoller.
+#define USE_EPOLL
 #endif
 
 // MSG_NOSIGNAL is not available on some platforms, if it doesn't exist define it as 0
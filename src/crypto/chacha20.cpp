@@ -12,6 +12,63 @@
 #include <algorithm>
 #include <bit>
 #include <cassert>
+#include <string>
+
+#include <compat/cpuid.h> // IWYU pragma: keep
+
+#if defined(ENABLE_AVX2)
+namespace chacha20_avx2
+{
+void Crypt_8way(const uint32_t* input, const std::byte* in, std::byte* out, size_t blocks);
+}
+#endif
+
+namespace {
+/** Produce the keystream for, or en/decipher if in is not null, a multiple of 8 blocks. Does not update the block counter in input. */
+typedef void (*Crypt8WayType)(const uint32_t*, const std::byte*, std::byte*, size_t);
+Crypt8WayType Crypt_8way = nullptr;
+
+/** Run Crypt_8way on as many whole groups of 8 blocks as possible, advance the block counter, and return the number of blocks done. */
+size_t CryptMultiBlock(uint32_t* input, const std::byte* in, std::byte* out, size_t blocks)
+{
+    if (!Crypt_8way || blocks < 8) return 0;
+    const size_t done{blocks & ~size_t{7}};
+    Crypt_8way(input, in, out, done);
+    const uint64_t counter{(input[8] | (uint64_t{input[9]} << 32)) + done};
+    input[8] = uint32_t(counter);
+    input[9] = uint32_t(counter >> 32);
+    return done;
+}
+
+#if defined(HAVE_GETCPUID) && defined(ENABLE_AVX2)
+/** Check whether the OS has enabled AVX registers. */
+bool AVXEnabled()
+{
+    uint32_t a, d;
+    __asm__("xgetbv" : "=a"(a), "=d"(d) : "c"(0));
+    return (a & 6) == 6;
+}
+#endif
+} // namespace
+
+std::string ChaCha20AutoDetect([[maybe_unused]] chacha20_implementation::UseImplementation use_implementation)
+{
+    Crypt_8way = nullptr;
+#if defined(HAVE_GETCPUID) && defined(ENABLE_AVX2)
+    if (use_implementation & chacha20_implementation::USE_AVX2) {
+        uint32_t eax, ebx, ecx, edx;
+        GetCPUID(1, 0, eax, ebx, ecx, edx);
+        const bool have_avx{((ecx >> 27) & 1) && ((ecx >> 28) & 1) && AVXEnabled()};
+        GetCPUID(7, 0, eax, ebx, ecx, edx);
+        const bool have_avx2{((ebx >> 5) & 1) != 0};
+        if (have_avx && have_avx2) {
+            Crypt_8way = chacha20_avx2::Crypt_8way;
+            return "avx2(8way)";
+        }
+    }
+#endif
+    return "standard";
+}
 
 #define QUARTERROUND(a,b,c,d) \
   a += b; d = std::rotl(d ^ a, 16); \
@@ -65,6 +122,9 @@ inline void ChaCha20Aligned::Keystream(std::span<std::byte> output) noexcept
     uint32_t x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12, x13, x14, x15;
     uint32_t j4, j5, j6, j7, j8, j9, j10, j11, j12, j13, j14, j15;
 
+    const size_t done{CryptMultiBlock(input, nullptr, c, blocks)};
+    c += done * BLOCKLEN;
+    blocks -= done;
     if (!blocks) return;
 
     j4 = input[0];
@@ -168,6 +228,10 @@ inline void ChaCha20Aligned::Crypt(std::span<const std::byte> in_bytes, std::spa
     uint32_t x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12, x13, x14, x15;
     uint32_t j4, j5, j6, j7, j8, j9, j10, j11, j12, j13, j14, j15;
 
+    const size_t done{CryptMultiBlock(input, m, c, blocks)};
+    m += done * BLOCKLEN;
+    c += done * BLOCKLEN;
+    blocks -= done;
     if (!blocks) return;
 
     j4 = input[0];
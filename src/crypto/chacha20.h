@@ -9,6 +9,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <span>
+#include <string>
 #include <utility>
 
 // classes for ChaCha20 256-bit stream cipher developed by Daniel J. Bernstein
@@ -19,6 +20,19 @@
 // the first 32-bit part of the nonce is automatically incremented, making it
 // conceptually compatible with variants that use a 64/64 split instead.
 
+namespace chacha20_implementation {
+enum UseImplementation : uint8_t {
+    STANDARD = 0,
+    USE_AVX2 = 1 << 0,
+    USE_ALL = USE_AVX2,
+};
+}
+
+/** Autodetect the best available ChaCha20 implementation for processing 8
+ *  or more blocks at once. Returns the name of the implementation.
+ */
+std::string ChaCha20AutoDetect(chacha20_implementation::UseImplementation use_implementation = chacha20_implementation::USE_ALL);
+
 /** ChaCha20 cipher that only operates on multiples of 64 bytes. */
 class ChaCha20Aligned
 {
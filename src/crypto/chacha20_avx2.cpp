@@ -0,0 +1,133 @@
+// Copyright (c) 2026-present The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// An 8-way ChaCha20 implementation: every 256-bit register holds the same
+// state word of 8 consecutive blocks, and the results are transposed back
+// into block order before being written out.
+
+#ifdef ENABLE_AVX2
+
+#include <attributes.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+
+namespace chacha20_avx2 {
+namespace {
+
+__m256i inline K(uint32_t x) { return _mm256_set1_epi32(x); }
+
+__m256i inline Add(__m256i x, __m256i y) { return _mm256_add_epi32(x, y); }
+__m256i inline Xor(__m256i x, __m256i y) { return _mm256_xor_si256(x, y); }
+
+template <int n>
+__m256i inline RotL(__m256i x)
+{
+    if constexpr (n == 16) {
+        return _mm256_shuffle_epi8(x, _mm256_set_epi8(13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2,
+                                                      13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2));
+    } else if constexpr (n == 8) {
+        return _mm256_shuffle_epi8(x, _mm256_set_epi8(14, 13, 12, 15, 10, 9, 8, 11, 6, 5, 4, 7, 2, 1, 0, 3,
+                                                      14, 13, 12, 15, 10, 9, 8, 11, 6, 5, 4, 7, 2, 1, 0, 3));
+    } else {
+        return _mm256_or_si256(_mm256_slli_epi32(x, n), _mm256_srli_epi32(x, 32 - n));
+    }
+}
+
+void ALWAYS_INLINE QuarterRound(__m256i& a, __m256i& b, __m256i& c, __m256i& d)
+{
+    a = Add(a, b); d = RotL<16>(Xor(d, a));
+    c = Add(c, d); b = RotL<12>(Xor(b, c));
+    a = Add(a, b); d = RotL<8>(Xor(d, a));
+    c = Add(c, d); b = RotL<7>(Xor(b, c));
+}
+
+/** Transpose 8 registers holding one word of 8 blocks into 8 registers holding 8 words of one block. */
+void inline Transpose(__m256i* x)
+{
+    const __m256i t0 = _mm256_unpacklo_epi32(x[0], x[1]);
+    const __m256i t1 = _mm256_unpackhi_epi32(x[0], x[1]);
+    const __m256i t2 = _mm256_unpacklo_epi32(x[2], x[3]);
+    const __m256i t3 = _mm256_unpackhi_epi32(x[2], x[3]);
+    const __m256i t4 = _mm256_unpacklo_epi32(x[4], x[5]);
+    const __m256i t5 = _mm256_unpackhi_epi32(x[4], x[5]);
+    const __m256i t6 = _mm256_unpacklo_epi32(x[6], x[7]);
+    const __m256i t7 = _mm256_unpackhi_epi32(x[6], x[7]);
+    const __m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+    const __m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+    const __m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+    const __m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+    const __m256i u4 = _mm256_unpacklo_epi64(t4, t6);
+    const __m256i u5 = _mm256_unpackhi_epi64(t4, t6);
+    const __m256i u6 = _mm256_unpacklo_epi64(t5, t7);
+    const __m256i u7 = _mm256_unpackhi_epi64(t5, t7);
+    x[0] = _mm256_permute2x128_si256(u0, u4, 0x20);
+    x[1] = _mm256_permute2x128_si256(u1, u5, 0x20);
+    x[2] = _mm256_permute2x128_si256(u2, u6, 0x20);
+    x[3] = _mm256_permute2x128_si256(u3, u7, 0x20);
+    x[4] = _mm256_permute2x128_si256(u0, u4, 0x31);
+    x[5] = _mm256_permute2x128_si256(u1, u5, 0x31);
+    x[6] = _mm256_permute2x128_si256(u2, u6, 0x31);
+    x[7] = _mm256_permute2x128_si256(u3, u7, 0x31);
+}
+
+/** Write the 32 bytes of each block in x (after Transpose) to out, xored with in if it is not null. */
+void inline Output(const std::byte* in, std::byte* out, int offset, const __m256i* x)
+{
+    for (int block = 0; block < 8; ++block) {
+        __m256i v = x[block];
+        if (in) v = Xor(v, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 64 * block + offset)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 64 * block + offset), v);
+    }
+}
+
+}
+
+void Crypt_8way(const uint32_t* input, const std::byte* in, std::byte* out, size_t blocks)
+{
+    uint64_t counter = input[8] | (uint64_t{input[9]} << 32);
+    for (; blocks >= 8; blocks -= 8) {
+        uint32_t ctr_lo[8], ctr_hi[8];
+        for (int i = 0; i < 8; ++i) {
+            ctr_lo[i] = uint32_t(counter + i);
+            ctr_hi[i] = uint32_t((counter + i) >> 32);
+        }
+        const __m256i j[16] = {
+            K(0x61707865), K(0x3320646e), K(0x79622d32), K(0x6b206574),
+            K(input[0]), K(input[1]), K(input[2]), K(input[3]),
+            K(input[4]), K(input[5]), K(input[6]), K(input[7]),
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ctr_lo)),
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ctr_hi)),
+            K(input[10]), K(input[11]),
+        };
+        __m256i x[16];
+        for (int i = 0; i < 16; ++i) x[i] = j[i];
+
+        for (int round = 0; round < 10; ++round) {
+            QuarterRound(x[0], x[4], x[8], x[12]);
+            QuarterRound(x[1], x[5], x[9], x[13]);
+            QuarterRound(x[2], x[6], x[10], x[14]);
+            QuarterRound(x[3], x[7], x[11], x[15]);
+            QuarterRound(x[0], x[5], x[10], x[15]);
+            QuarterRound(x[1], x[6], x[11], x[12]);
+            QuarterRound(x[2], x[7], x[8], x[13]);
+            QuarterRound(x[3], x[4], x[9], x[14]);
+        }
+
+        for (int i = 0; i < 16; ++i) x[i] = Add(x[i], j[i]);
+        Transpose(x);
+        Transpose(x + 8);
+        Output(in, out, 0, x);
+        Output(in, out, 32, x + 8);
+
+        counter += 8;
+        if (in) in += 512;
+        out += 512;
+    }
+}
+
+}
+
+#endif
@@ -6,8 +6,11 @@
 #include <crypto/common.h>
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cstring>
+#include <span>
+#include <vector>
 
 #if !defined(DISABLE_OPTIMIZED_SHA256)
 #include <compat/cpuid.h> // IWYU pragma: keep
@@ -39,6 +42,11 @@ namespace sha256d64_avx2
 void Transform_8way(unsigned char* out, const unsigned char* in);
 }
 
+namespace sha256_avx2
+{
+void TransformMulti_8way(uint32_t* s, const unsigned char* const* chunks);
+}
+
 namespace sha256d64_x86_shani
 {
 void Transform_2way(unsigned char* out, const unsigned char* in);
@@ -437,6 +445,7 @@ void TransformD64(unsigned char* out, const unsigned char* in)
 
 typedef void (*TransformType)(uint32_t*, const unsigned char*, size_t);
 typedef void (*TransformD64Type)(unsigned char*, const unsigned char*);
+typedef void (*TransformMultiType)(uint32_t*, const unsigned char* const*);
 
 template<TransformType tr>
 void TransformD64Wrapper(unsigned char* out, const unsigned char* in)
@@ -482,6 +491,8 @@ TransformD64Type TransformD64 = sha256::TransformD64;
 TransformD64Type TransformD64_2way = nullptr;
 TransformD64Type TransformD64_4way = nullptr;
 TransformD64Type TransformD64_8way = nullptr;
+/** Transform one 64-byte block in each of 8 lanes. The state is stored word-major: s[8 * word + lane]. */
+TransformMultiType TransformMulti_8way = nullptr;
 
 bool SelfTest() {
     // Input state (equal to the initial SHA256 state)
@@ -565,9 +576,121 @@ bool SelfTest() {
         if (!std::equal(out, out + 256, result_d64)) return false;
     }
 
+    // Test TransformMulti_8way, if available, by hashing the first i input blocks in lane i.
+    if (TransformMulti_8way) {
+        uint32_t state[64];
+        for (int lane = 0; lane < 8; ++lane) {
+            for (int w = 0; w < 8; ++w) state[8 * w + lane] = init[w];
+        }
+        const unsigned char* chunks[8];
+        for (int block = 0; block < 8; ++block) {
+            uint32_t before[64];
+            std::copy(state, state + 64, before);
+            std::fill(chunks, chunks + 8, data + 1 + 64 * block);
+            TransformMulti_8way(state, chunks);
+            // Lanes that already hashed all their blocks keep their state.
+            for (int lane = 0; lane <= block; ++lane) {
+                for (int w = 0; w < 8; ++w) state[8 * w + lane] = before[8 * w + lane];
+            }
+        }
+        for (int lane = 0; lane < 8; ++lane) {
+            for (int w = 0; w < 8; ++w) {
+                if (state[8 * w + lane] != result[lane][w]) return false;
+            }
+        }
+    }
+
     return true;
 }
 
+/** Compute the SHA256 of each input, spreading the messages over the lanes of TransformMulti_8way. */
+void SHA256Multi_8way(unsigned char* out, std::span<const std::span<const unsigned char>> inputs)
+{
+    /** A message being hashed in one lane. */
+    struct Lane {
+        size_t index;
+        const unsigned char* data;
+        size_t blocks;
+        //! The final partial block of the message, followed by the padding.
+        unsigned char tail[128];
+        size_t tail_pos;
+        size_t tail_blocks;
+    };
+    static const unsigned char unused[64] = {};
+
+    std::array<Lane, 8> lanes;
+    std::array<bool, 8> busy{};
+    uint32_t state[64];
+    const unsigned char* chunks[8];
+    size_t next{0};
+
+    const auto start{[&](size_t lane) {
+        Lane& l{lanes[lane]};
+        const auto input{inputs[next]};
+        const size_t rem{input.size() % 64};
+        l.index = next++;
+        l.data = input.data();
+        l.blocks = input.size() / 64;
+        l.tail_pos = 0;
+        l.tail_blocks = rem < 56 ? 1 : 2;
+        std::fill(l.tail, l.tail + sizeof(l.tail), 0);
+        if (rem) memcpy(l.tail, input.data() + 64 * l.blocks, rem);
+        l.tail[rem] = 0x80;
+        WriteBE64(l.tail + 64 * l.tail_blocks - 8, uint64_t{input.size()} << 3);
+        uint32_t init[8];
+        sha256::Initialize(init);
+        for (int w = 0; w < 8; ++w) state[8 * w + lane] = init[w];
+        busy[lane] = true;
+    }};
+    // Returns nullptr once all blocks of the lane's message have been handed out.
+    const auto next_block{[&](size_t lane) -> const unsigned char* {
+        Lane& l{lanes[lane]};
+        if (l.blocks) {
+            --l.blocks;
+            l.data += 64;
+            return l.data - 64;
+        }
+        if (l.tail_pos < l.tail_blocks) return l.tail + 64 * l.tail_pos++;
+        return nullptr;
+    }};
+    const auto finish{[&](size_t lane, const uint32_t* s, size_t stride) {
+        for (int w = 0; w < 8; ++w) WriteBE32(out + 32 * lanes[lane].index + 4 * w, s[stride * w]);
+        busy[lane] = false;
+    }};
+
+    while (true) {
+        int active{0};
+        for (size_t lane = 0; lane < 8; ++lane) {
+            const unsigned char* chunk{busy[lane] ? next_block(lane) : nullptr};
+            if (!chunk) {
+                if (busy[lane]) finish(lane, state + lane, 8);
+                if (next < inputs.size()) {
+                    start(lane);
+                    chunk = next_block(lane);
+                }
+            }
+            chunks[lane] = chunk ? chunk : unused;
+            active += chunk != nullptr;
+        }
+        if (active == 0) break;
+        if (active <= 2 && next == inputs.size()) {
+            // Running the multi-lane transform for one or two lanes is slower
+            // than the single-lane one, so finish the stragglers with that.
+            for (size_t lane = 0; lane < 8; ++lane) {
+                if (!busy[lane]) continue;
+                uint32_t s[8];
+                for (int w = 0; w < 8; ++w) s[w] = state[8 * w + lane];
+                for (const unsigned char* chunk{chunks[lane]}; chunk; chunk = next_block(lane)) {
+                    Transform(s, chunk, 1);
+                }
+                finish(lane, s, 1);
+            }
+            break;
+        }
+        TransformMulti_8way(state, chunks);
+    }
+}
+
 #if !defined(DISABLE_OPTIMIZED_SHA256)
 #if (defined(__x86_64__) || defined(__amd64__) || defined(__i386__))
 /** Check whether the OS has enabled AVX registers. */
@@ -590,6 +713,7 @@ std::string SHA256AutoDetect(sha256_implementation::UseImplementation use_implem
     TransformD64_2way = nullptr;
     TransformD64_4way = nullptr;
     TransformD64_8way = nullptr;
+    TransformMulti_8way = nullptr;
 
 #if !defined(DISABLE_OPTIMIZED_SHA256)
 #if defined(HAVE_GETCPUID)
@@ -646,6 +770,7 @@ std::string SHA256AutoDetect(sha256_implementation::UseImplementation use_implem
 #if defined(ENABLE_AVX2)
     if (have_avx2 && have_avx && enabled_avx) {
         TransformD64_8way = sha256d64_avx2::Transform_8way;
+        TransformMulti_8way = sha256_avx2::TransformMulti_8way;
         ret += ";avx2(8way)";
     }
 #endif
@@ -779,3 +904,25 @@ void SHA256D64(unsigned char* out, const unsigned char* in, size_t blocks)
         --blocks;
     }
 }
+
+void SHA256DMulti(unsigned char* out, std::span<const std::span<const unsigned char>> inputs)
+{
+    if (!TransformMulti_8way) {
+        for (const auto& input : inputs) {
+            unsigned char hash[CSHA256::OUTPUT_SIZE];
+            CSHA256().Write(input.data(), input.size()).Finalize(hash);
+            CSHA256().Write(hash, sizeof(hash)).Finalize(out);
+            out += CSHA256::OUTPUT_SIZE;
+        }
+        return;
+    }
+
+    std::vector<unsigned char> hashes(inputs.size() * CSHA256::OUTPUT_SIZE);
+    SHA256Multi_8way(hashes.data(), inputs);
+    std::vector<std::span<const unsigned char>> second;
+    second.reserve(inputs.size());
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        second.emplace_back(hashes.data() + i * CSHA256::OUTPUT_SIZE, CSHA256::OUTPUT_SIZE);
+    }
+    SHA256Multi_8way(out, second);
+}
@@ -7,6 +7,7 @@
 
 #include <cstdint>
 #include <cstdlib>
+#include <span>
 #include <string>
 
 /** A hasher class for SHA-256. */
@@ -50,4 +51,14 @@ std::string SHA256AutoDetect(sha256_implementation::UseImplementation use_implem
  */
 void SHA256D64(unsigned char* output, const unsigned char* input, size_t blocks);
 
+/** Compute the double-SHA256's of multiple variable-length messages.
+ *  output:  pointer to an inputs.size()*32 byte output buffer
+ *  inputs:  the messages to hash.
+ *
+ *  When a multi-lane implementation is available, messages are interleaved
+ *  across its lanes, and a lane that finishes its message is refilled with the
+ *  next one.
+ */
+void SHA256DMulti(unsigned char* output, std::span<const std::span<const unsigned char>> inputs);
+
 #endif // BITCOIN_CRYPTO_SHA256_H
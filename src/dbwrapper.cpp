@@ -24,13 +24,19 @@
 #include <util/log.h>
 #include <util/obfuscation.h>
 #include <util/strencodings.h>
+#include <util/time.h>
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
 #include <cassert>
+#include <chrono>
 #include <cstdarg>
 #include <cstdint>
 #include <cstdio>
 #include <memory>
+#include <numeric>
 #include <optional>
 #include <utility>
 
@@ -215,6 +221,29 @@ struct LevelDBContext {
 
     //! the database itself
     leveldb::DB* pdb;
+
+    //! counters behind CDBWrapper::GetStats(), updated by concurrent readers
+    std::atomic<uint64_t> reads{0};
+    std::atomic<uint64_t> reads_found{0};
+    std::atomic<uint64_t> read_bytes{0};
+    std::atomic<uint64_t> read_time_us{0};
+    std::array<std::atomic<uint64_t>, DBStats::READ_LATENCY_BUCKETS> read_latency{};
+    std::atomic<uint64_t> batches_written{0};
+    std::atomic<uint64_t> write_bytes{0};
+    std::atomic<uint64_t> write_time_us{0};
+
+    //! Count a point lookup, with the size of the value if it was found.
+    void RecordRead(SteadyClock::duration elapsed, std::optional<size_t> value_size)
+    {
+        const auto us{uint64_t(Ticks<std::chrono::microseconds>(elapsed))};
+        reads.fetch_add(1, std::memory_order_relaxed);
+        if (value_size) {
+            reads_found.fetch_add(1, std::memory_order_relaxed);
+            read_bytes.fetch_add(*value_size, std::memory_order_relaxed);
+        }
+        read_time_us.fetch_add(us, std::memory_order_relaxed);
+        read_latency[std::min<size_t>(std::bit_width(us), DBStats::READ_LATENCY_BUCKETS - 1)].fetch_add(1, std::memory_order_relaxed);
+    }
 };
 
 CDBWrapper::CDBWrapper(const DBParams& params)
@@ -292,8 +321,12 @@ void CDBWrapper::WriteBatch(CDBBatch& batch, bool fSync)
     if (log_memory) {
         mem_before = DynamicMemoryUsage() / double(1_MiB);
     }
+    const auto start{SteadyClock::now()};
     leveldb::Status status = DBContext().pdb->Write(fSync ? DBContext().syncoptions : DBContext().writeoptions, &batch.m_impl_batch->batch);
     HandleError(status);
+    DBContext().batches_written.fetch_add(1, std::memory_order_relaxed);
+    DBContext().write_bytes.fetch_add(batch.ApproximateSize(), std::memory_order_relaxed);
+    DBContext().write_time_us.fetch_add(uint64_t(Ticks<std::chrono::microseconds>(SteadyClock::now() - start)), std::memory_order_relaxed);
     if (log_memory) {
         double mem_after{DynamicMemoryUsage() / double(1_MiB)};
         LogDebug(BCLog::LEVELDB, "WriteBatch memory usage: db=%s, before=%.1fMiB, after=%.1fMiB\n",
@@ -319,32 +352,94 @@ size_t CDBWrapper::DynamicMemoryUsage() const
     return parsed.value();
 }
 
+DBStats CDBWrapper::GetStats() const
+{
+    const auto& ctx{DBContext()};
+    DBStats stats{
+        .reads = ctx.reads.load(std::memory_order_relaxed),
+        .reads_found = ctx.reads_found.load(std::memory_order_relaxed),
+        .read_bytes = ctx.read_bytes.load(std::memory_order_relaxed),
+        .read_time = std::chrono::microseconds{ctx.read_time_us.load(std::memory_order_relaxed)},
+        .batches_written = ctx.batches_written.load(std::memory_order_relaxed),
+        .write_bytes = ctx.write_bytes.load(std::memory_order_relaxed),
+        .write_time = std::chrono::microseconds{ctx.write_time_us.load(std::memory_order_relaxed)},
+    };
+    for (size_t i{0}; i < DBStats::READ_LATENCY_BUCKETS; ++i) {
+        stats.read_latency[i] = ctx.read_latency[i].load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
 std::optional<std::string> CDBWrapper::ReadImpl(std::span<const std::byte> key) const
 {
     leveldb::Slice slKey(CharCast(key.data()), key.size());
     std::string strValue;
+    const auto start{SteadyClock::now()};
     leveldb::Status status = DBContext().pdb->Get(DBContext().readoptions, slKey, &strValue);
     if (!status.ok()) {
-        if (status.IsNotFound())
+        if (status.IsNotFound()) {
+            DBContext().RecordRead(SteadyClock::now() - start, std::nullopt);
             return std::nullopt;
+        }
         LogError("LevelDB read failure: %s", status.ToString());
         HandleError(status);
     }
+    DBContext().RecordRead(SteadyClock::now() - start, strValue.size());
     return strValue;
 }
 
+std::vector<std::optional<std::string>> CDBWrapper::MultiReadImpl(std::span<const DataStream> keys) const
+{
+    std::vector<size_t> order(keys.size());
+    std::iota(order.begin(), order.end(), size_t{0});
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        // LevelDB's default comparator orders keys bytewise.
+        return std::ranges::lexicographical_compare(std::span<const std::byte>{keys[a]}, std::span<const std::byte>{keys[b]});
+    });
+
+    leveldb::DB& db{*DBContext().pdb};
+    const auto snapshot_deleter{[&db](const leveldb::Snapshot* snapshot) { db.ReleaseSnapshot(snapshot); }};
+    const std::unique_ptr<const leveldb::Snapshot, decltype(snapshot_deleter)> snapshot{db.GetSnapshot(), snapshot_deleter};
+    leveldb::ReadOptions options{DBContext().readoptions};
+    options.snapshot = snapshot.get();
+
+    std::vector<std::optional<std::string>> values(keys.size());
+    for (const size_t i : order) {
+        const std::span<const std::byte> key{keys[i]};
+        leveldb::Slice slKey(CharCast(key.data()), key.size());
+        std::string strValue;
+        const auto start{SteadyClock::now()};
+        leveldb::Status status = db.Get(options, slKey, &strValue);
+        if (!status.ok()) {
+            if (status.IsNotFound()) {
+                DBContext().RecordRead(SteadyClock::now() - start, std::nullopt);
+                continue;
+            }
+            LogError("LevelDB read failure: %s", status.ToString());
+            HandleError(status);
+        }
+        DBContext().RecordRead(SteadyClock::now() - start, strValue.size());
+        values[i] = std::move(strValue);
+    }
+    return values;
+}
+
 bool CDBWrapper::ExistsImpl(std::span<const std::byte> key) const
 {
     leveldb::Slice slKey(CharCast(key.data()), key.size());
 
     std::string strValue;
+    const auto start{SteadyClock::now()};
     leveldb::Status status = DBContext().pdb->Get(DBContext().readoptions, slKey, &strValue);
     if (!status.ok()) {
-        if (status.IsNotFound())
+        if (status.IsNotFound()) {
+            DBContext().RecordRead(SteadyClock::now() - start, std::nullopt);
             return false;
+        }
         LogError("LevelDB read failure: %s", status.ToString());
         HandleError(status);
     }
+    DBContext().RecordRead(SteadyClock::now() - start, strValue.size());
     return true;
 }
 
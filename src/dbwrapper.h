@@ -14,6 +14,8 @@
 #include <util/fs.h>
 #include <util/obfuscation.h>
 
+#include <array>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <exception>
@@ -22,6 +24,7 @@
 #include <span>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 namespace leveldb {
 class Env;
@@ -37,6 +40,27 @@ struct DBOptions {
     bool force_compact = false;
 };
 
+//! Cumulative counters of the reads and writes made through a CDBWrapper.
+struct DBStats {
+    //! Number of read latency buckets. Bucket i counts lookups that took less
+    //! than 2^i microseconds, the last one also counts all slower lookups.
+    static constexpr size_t READ_LATENCY_BUCKETS{16};
+
+    //! Point lookups, including existence checks and each key of a MultiRead().
+    uint64_t reads{0};
+    //! Lookups that found their key.
+    uint64_t reads_found{0};
+    //! Size of the values read.
+    uint64_t read_bytes{0};
+    std::chrono::microseconds read_time{0};
+    std::array<uint64_t, READ_LATENCY_BUCKETS> read_latency{};
+    uint64_t batches_written{0};
+    //! Approximate size of the batches written.
+    uint64_t write_bytes{0};
+    //! Time spent writing batches, including any stalls while LevelDB compacts.
+    std::chrono::microseconds write_time{0};
+};
+
 //! Application-specific storage settings.
 struct DBParams {
     //! Location in the filesystem where leveldb data will be stored.
@@ -205,6 +229,7 @@ private:
     inline static const std::string OBFUSCATION_KEY{"\000obfuscate_key", 14}; // explicit size to avoid truncation at leading \0
 
     std::optional<std::string> ReadImpl(std::span<const std::byte> key) const;
+    std::vector<std::optional<std::string>> MultiReadImpl(std::span<const DataStream> keys) const;
     bool ExistsImpl(std::span<const std::byte> key) const;
     size_t EstimateSizeImpl(std::span<const std::byte> key1, std::span<const std::byte> key2) const;
     auto& DBContext() const LIFETIMEBOUND { return *Assert(m_db_context); }
@@ -236,6 +261,35 @@ public:
         return true;
     }
 
+    /**
+     * Read the values of several keys from one snapshot of the database.
+     * Lookups are done in key order, so that keys stored in the same table or
+     * block are read one after another while it is still cached. Missing or
+     * undecodable values are returned as std::nullopt, in the order of keys.
+     */
+    template <typename V, typename K>
+    std::vector<std::optional<V>> MultiRead(std::span<const K> keys) const
+    {
+        std::vector<DataStream> ser_keys(keys.size());
+        for (size_t i{0}; i < keys.size(); ++i) {
+            ser_keys[i].reserve(DBWRAPPER_PREALLOC_KEY_SIZE);
+            ser_keys[i] << keys[i];
+        }
+        std::vector<std::optional<V>> values(keys.size());
+        auto str_values{MultiReadImpl(ser_keys)};
+        for (size_t i{0}; i < keys.size(); ++i) {
+            if (!str_values[i]) continue;
+            try {
+                std::span ssValue{MakeWritableByteSpan(*str_values[i])};
+                m_obfuscation(ssValue);
+                SpanReader{ssValue} >> values[i].emplace();
+            } catch (const std::exception&) {
+                values[i].reset();
+            }
+        }
+        return values;
+    }
+
     template <typename K, typename V>
     void Write(const K& key, const V& value, bool fSync = false)
     {
@@ -272,6 +326,9 @@ public:
     // Get an estimate of LevelDB memory usage (in bytes).
     size_t DynamicMemoryUsage() const;
 
+    //! Return the read and write counters since this database was opened.
+    DBStats GetStats() const;
+
     CDBIterator* NewIterator();
 
     /**
@@ -964,9 +964,7 @@ void HTTPServer::ThreadSocketHandler()
         // empty sets.
         auto io_readiness{GenerateWaitSockets()};
         if (io_readiness.events_per_sock.empty() ||
-            // WaitMany() may as well be a static method, the context of the first Sock in the vector is not relevant.
-            !io_readiness.events_per_sock.begin()->first->WaitMany(SELECT_TIMEOUT,
-                                                                   io_readiness.events_per_sock)) {
+            !m_sock_poller.WaitMany(SELECT_TIMEOUT, io_readiness.events_per_sock)) {
             m_interrupt_net.sleep_for(SELECT_TIMEOUT);
         }
 
@@ -979,6 +977,8 @@ void HTTPServer::ThreadSocketHandler()
         // Disconnect any clients that have been flagged.
         DisconnectClients();
     }
+    // Release the sockets of disconnected clients and listening sockets.
+    m_sock_poller.Clear();
 }
 
 void HTTPServer::MaybeDispatchRequestsFromClient(const std::shared_ptr<HTTPRemoteClient>& client) const
@@ -355,6 +355,12 @@ private:
      */
     CThreadInterrupt m_interrupt_net;
 
+    /**
+     * Waits for readiness of the sockets in ThreadSocketHandler(). Only accessed by
+     * m_thread_socket_handler.
+     */
+    SockPoller m_sock_poller;
+
     /**
      * Thread that sends to and receives from sockets and accepts connections.
      * Executes the I/O loop of the server.
@@ -7,6 +7,7 @@
 #include <chain.h>
 #include <common/args.h>
 #include <dbwrapper.h>
+#include <flatfile.h>
 #include <interfaces/chain.h>
 #include <interfaces/types.h>
 #include <kernel/types.h>
@@ -22,10 +23,12 @@
 #include <undo.h>
 #include <util/check.h>
 #include <util/fs.h>
+#include <util/hasher.h>
 #include <util/log.h>
 #include <util/string.h>
 #include <util/thread.h>
 #include <util/threadinterrupt.h>
+#include <util/threadpool.h>
 #include <util/time.h>
 #include <util/translation.h>
 #include <validation.h>
@@ -33,12 +36,17 @@
 
 #include <compare>
 #include <cstdint>
+#include <deque>
 #include <functional>
+#include <future>
+#include <map>
 #include <memory>
 #include <optional>
+#include <set>
 #include <stdexcept>
 #include <string>
 #include <thread>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -48,6 +56,125 @@ constexpr uint8_t DB_BEST_BLOCK{'B'};
 
 constexpr auto SYNC_LOG_INTERVAL{30s};
 constexpr auto SYNC_LOCATOR_WRITE_INTERVAL{30s};
+//! Number of upcoming blocks read and prepared on the validation thread pool during sync.
+constexpr size_t SYNC_LOOKAHEAD_BLOCKS{16};
+//! Maximum distance between syncing indexes for them to share block reads.
+constexpr int SYNC_SHARED_BLOCKS{32};
+
+namespace {
+//! Block and undo data read for the initial sync of an index.
+struct SyncBlockData {
+    CBlock block;
+    CBlockUndo undo;
+};
+
+/**
+ * Shares block reads between indexes whose initial syncs run at the same time.
+ * A block read for one index is kept until the other syncing indexes that are
+ * at most SYNC_SHARED_BLOCKS behind it have taken it as well. Those indexes do
+ * not read and deserialize the block again, which lets them catch up with the
+ * index ahead of them. Indexes further behind read blocks on their own.
+ */
+class SyncBlockSharing
+{
+private:
+    struct Reader {
+        int height;
+        bool undo;
+    };
+    struct Entry {
+        int height;
+        bool has_undo;
+        std::shared_future<std::shared_ptr<const SyncBlockData>> data;
+        //! Indexes that are expected to take the block, but have not yet.
+        std::set<const BaseIndex*> pending;
+    };
+
+    Mutex m_mutex;
+    //! Indexes that are syncing, with the height they have appended up to.
+    std::map<const BaseIndex*, Reader> m_readers GUARDED_BY(m_mutex);
+    std::unordered_map<uint256, Entry, BlockHasher> m_blocks GUARDED_BY(m_mutex);
+
+    //! Stop holding blocks for reader for which pred returns true.
+    void Release(const BaseIndex& reader, const std::function<bool(const Entry&)>& pred) EXCLUSIVE_LOCKS_REQUIRED(m_mutex)
+    {
+        for (auto it{m_blocks.begin()}; it != m_blocks.end();) {
+            if (pred(it->second) && it->second.pending.erase(&reader) && it->second.pending.empty()) {
+                it = m_blocks.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+public:
+    void Register(const BaseIndex& reader, int height, bool undo) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        LOCK(m_mutex);
+        m_readers.insert_or_assign(&reader, Reader{.height = height, .undo = undo});
+    }
+
+    void Unregister(const BaseIndex& reader) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        LOCK(m_mutex);
+        m_readers.erase(&reader);
+        Release(reader, [](const Entry&) { return true; });
+    }
+
+    //! Record that reader appended the block at height, so it won't take blocks up to it anymore.
+    void SetHeight(const BaseIndex& reader, int height) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        LOCK(m_mutex);
+        if (const auto it{m_readers.find(&reader)}; it != m_readers.end()) it->second.height = height;
+        Release(reader, [height](const Entry& entry) { return entry.height <= height; });
+    }
+
+    /**
+     * Return the block, and its undo data if undo is set, either as read for another index or
+     * by reading it from block_pos and undo_pos. Returns nullptr if reading fails.
+     */
+    std::shared_ptr<const SyncBlockData> Read(const BaseIndex& reader, const node::BlockManager& blockman, const CBlockIndex& index,
+                                              const FlatFilePos& block_pos, const FlatFilePos& undo_pos, bool undo) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        const uint256& hash{*index.phashBlock};
+        std::promise<std::shared_ptr<const SyncBlockData>> promise;
+        std::shared_future<std::shared_ptr<const SyncBlockData>> shared;
+        bool read_undo{undo};
+        {
+            LOCK(m_mutex);
+            if (auto it{m_blocks.find(hash)}; it != m_blocks.end() && (it->second.has_undo || !undo)) {
+                shared = it->second.data;
+                if (it->second.pending.erase(&reader) && it->second.pending.empty()) m_blocks.erase(it);
+            } else {
+                Entry entry{.height = index.nHeight, .has_undo = undo, .data = promise.get_future().share(), .pending = {}};
+                for (const auto& [other, other_reader] : m_readers) {
+                    if (other == &reader || other_reader.height >= index.nHeight || index.nHeight - other_reader.height > SYNC_SHARED_BLOCKS) continue;
+                    entry.pending.insert(other);
+                    entry.has_undo |= other_reader.undo;
+                }
+                read_undo = entry.has_undo;
+                if (!entry.pending.empty()) m_blocks.insert_or_assign(hash, std::move(entry));
+            }
+        }
+        // Wait for the read of the index that got to the block first.
+        if (shared.valid()) return shared.get();
+
+        auto data{std::make_shared<SyncBlockData>()};
+        const bool ok{blockman.ReadBlock(data->block, block_pos, hash) &&
+                      (!read_undo || index.nHeight == 0 || blockman.ReadBlockUndo(data->undo, index, undo_pos))};
+        std::shared_ptr<const SyncBlockData> result{ok ? std::move(data) : nullptr};
+        promise.set_value(result);
+        return result;
+    }
+};
+
+SyncBlockSharing g_sync_block_sharing;
+} // namespace
+
+struct BaseIndex::PreparedBlock {
+    std::shared_ptr<const SyncBlockData> data;
+    std::function<bool()> append;
+};
 
 template <typename... Args>
 void BaseIndex::FatalErrorf(util::ConstevalFormatString<sizeof...(Args)> fmt, const Args&... args)
@@ -172,12 +299,32 @@ static const CBlockIndex* NextSyncBlock(const CBlockIndex* const pindex_prev, CC
     return chain.Next(*Assert(fork));
 }
 
-bool BaseIndex::ProcessBlock(const CBlockIndex* pindex, const CBlock* block_data)
+std::unique_ptr<BaseIndex::PreparedBlock> BaseIndex::PrepareBlock(const CBlockIndex& index, const FlatFilePos& block_pos, const FlatFilePos& undo_pos)
 {
-    interfaces::BlockInfo block_info = kernel::MakeBlockInfo(pindex, block_data);
+    const bool undo{CustomOptions().connect_undo_data};
+    auto prepared{std::make_unique<PreparedBlock>()};
+    prepared->data = g_sync_block_sharing.Read(*this, m_chainstate->m_blockman, index, block_pos, undo_pos, undo);
+    if (!prepared->data) return nullptr;
+    // Like kernel::MakeBlockInfo, but with the block position read by the caller under cs_main.
+    interfaces::BlockInfo block_info{*index.phashBlock};
+    block_info.prev_hash = index.pprev ? index.pprev->phashBlock : nullptr;
+    block_info.height = index.nHeight;
+    block_info.chain_time_max = index.GetBlockTimeMax();
+    block_info.file_number = block_pos.nFile;
+    block_info.data_pos = block_pos.nPos;
+    block_info.data = &prepared->data->block;
+    if (undo) block_info.undo_data = &prepared->data->undo;
+
+    prepared->append = CustomPrepare(block_info);
+    return prepared;
+}
+
+bool BaseIndex::ProcessBlock(const CBlockIndex* pindex, const CBlock* block_data, PreparedBlock* prepared)
+{
+    interfaces::BlockInfo block_info = kernel::MakeBlockInfo(pindex, prepared ? &prepared->data->block : block_data);
 
     CBlock block;
-    if (!block_data) { // disk lookup if block data wasn't provided
+    if (!block_info.data) { // disk lookup if block data wasn't provided
         if (!m_chainstate->m_blockman.ReadBlock(block, *pindex)) {
             FatalErrorf("Failed to read block %s from disk",
                         pindex->GetBlockHash().ToString());
@@ -188,15 +335,21 @@ bool BaseIndex::ProcessBlock(const CBlockIndex* pindex, const CBlock* block_data
 
     CBlockUndo block_undo;
     if (CustomOptions().connect_undo_data) {
-        if (pindex->nHeight > 0 && !m_chainstate->m_blockman.ReadBlockUndo(block_undo, *pindex)) {
-            FatalErrorf("Failed to read undo block data %s from disk",
-                        pindex->GetBlockHash().ToString());
-            return false;
+        if (prepared) {
+            block_info.undo_data = &prepared->data->undo;
+        } else {
+            if (pindex->nHeight > 0 && !m_chainstate->m_blockman.ReadBlockUndo(block_undo, *pindex)) {
+                FatalErrorf("Failed to read undo block data %s from disk",
+                            pindex->GetBlockHash().ToString());
+                return false;
+            }
+            block_info.undo_data = &block_undo;
         }
-        block_info.undo_data = &block_undo;
     }
 
-    if (!CustomAppend(block_info)) {
+    // Blocks prepared during sync have been passed to CustomPrepare already.
+    const auto append{prepared ? std::move(prepared->append) : CustomPrepare(block_info)};
+    if (!(append ? append() : CustomAppend(block_info))) {
         FatalErrorf("Failed to write block %s to index database",
                     pindex->GetBlockHash().ToString());
         return false;
@@ -209,6 +362,27 @@ void BaseIndex::Sync()
 {
     const CBlockIndex* pindex = m_best_block_index.load();
     if (!m_synced) {
+        // Blocks at and after the sync position on the active chain, in chain order, that are
+        // being prepared on the validation thread pool. The tasks refer to this index, so they
+        // are waited for before returning. Block reads are shared with other syncing indexes
+        // while this index is registered.
+        struct Lookahead {
+            const BaseIndex& index;
+            std::deque<std::pair<const CBlockIndex*, std::future<std::unique_ptr<PreparedBlock>>>> blocks;
+            void Clear()
+            {
+                for (auto& [_, prepared] : blocks) prepared.wait();
+                blocks.clear();
+            }
+            ~Lookahead()
+            {
+                Clear();
+                g_sync_block_sharing.Unregister(index);
+            }
+        } lookahead{.index = *this, .blocks = {}};
+        g_sync_block_sharing.Register(*this, pindex ? pindex->nHeight : -1, CustomOptions().connect_undo_data);
+        ThreadPool* const thread_pool{m_chain->context()->chainman->GetThreadPool().get()};
+
         auto last_log_time{NodeClock::now()};
         auto last_locator_write_time{last_log_time};
         while (true) {
@@ -249,8 +423,29 @@ void BaseIndex::Sync()
             }
             pindex = pindex_next;
 
+            // Blocks prepared for another chain are not needed anymore after a reorg.
+            if (!lookahead.blocks.empty() && lookahead.blocks.front().first != pindex) lookahead.Clear();
+            {
+                LOCK(cs_main);
+                const CBlockIndex* next{lookahead.blocks.empty() ? pindex : m_chainstate->m_chain.Next(*lookahead.blocks.back().first)};
+                while (next && lookahead.blocks.size() < SYNC_LOOKAHEAD_BLOCKS) {
+                    auto prepared{thread_pool->Submit([this, next, block_pos = next->GetBlockPos(), undo_pos = next->GetUndoPos()] {
+                        return PrepareBlock(*next, block_pos, undo_pos);
+                    })};
+                    // The pool has no workers or is shutting down, so blocks are read as they are appended.
+                    if (!prepared) break;
+                    lookahead.blocks.emplace_back(next, std::move(*prepared));
+                    next = m_chainstate->m_chain.Next(*next);
+                }
+            }
+            std::unique_ptr<PreparedBlock> prepared;
+            if (!lookahead.blocks.empty()) {
+                prepared = lookahead.blocks.front().second.get();
+                lookahead.blocks.pop_front();
+            }
 
-            if (!ProcessBlock(pindex)) return; // error logged internally
+            if (!ProcessBlock(pindex, /*block_data=*/nullptr, prepared.get())) return; // error logged internally
+            g_sync_block_sharing.SetHeight(*this, pindex->nHeight);
 
             auto current_time{NodeClock::now()};
             if (current_time - last_log_time >= SYNC_LOG_INTERVAL) {
@@ -17,6 +17,7 @@
 
 #include <atomic>
 #include <cstddef>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <string>
@@ -25,6 +26,7 @@
 class CBlock;
 class CBlockIndex;
 class Chainstate;
+struct FlatFilePos;
 
 struct CBlockLocator;
 struct IndexSummary {
@@ -102,7 +104,16 @@ private:
     /// Loop over disconnected blocks and call CustomRemove.
     bool Rewind(const CBlockIndex* current_tip, const CBlockIndex* new_tip);
 
-    bool ProcessBlock(const CBlockIndex* pindex, const CBlock* block_data = nullptr);
+    /// Block data read ahead of the sync position, and the result of CustomPrepare for it.
+    struct PreparedBlock;
+
+    /// Read a block from block_pos, and its undo data from undo_pos if needed, and call
+    /// CustomPrepare on it. Runs on the validation thread pool during the initial sync, so it
+    /// must not take cs_main. Returns nullptr if reading fails, in which case the error is
+    /// reported when ProcessBlock reads the block again.
+    std::unique_ptr<PreparedBlock> PrepareBlock(const CBlockIndex& index, const FlatFilePos& block_pos, const FlatFilePos& undo_pos);
+
+    bool ProcessBlock(const CBlockIndex* pindex, const CBlock* block_data = nullptr, PreparedBlock* prepared = nullptr);
 
     virtual bool AllowPrune() const = 0;
 
@@ -125,6 +136,15 @@ protected:
     /// Write update index entries for a newly connected block.
     [[nodiscard]] virtual bool CustomAppend(const interfaces::BlockInfo& block) { return true; }
 
+    /// Compute the index entries for a newly connected block that do not depend on earlier
+    /// blocks, and return a function that writes them, to be called instead of CustomAppend.
+    /// An empty function means CustomAppend is called as usual. During the initial sync this
+    /// runs on the validation thread pool for several upcoming blocks at once, concurrently
+    /// with appending earlier blocks, so it must not access state modified by appending or
+    /// removing blocks, and must not take cs_main. The returned functions are always called
+    /// in chain order.
+    [[nodiscard]] virtual std::function<bool()> CustomPrepare(const interfaces::BlockInfo& block) { return {}; }
+
     /// Virtual method called internally by Commit that can be overridden to atomically
     /// commit more index state.
     virtual bool CustomCommit(CDBBatch& batch) { return true; }
@@ -169,7 +189,8 @@ public:
     /// Intended to be run in its own thread, m_thread_sync, and can be
     /// interrupted with m_interrupt. Once the index gets in sync, the m_synced
     /// flag is set and the BlockConnected ValidationInterface callback takes
-    /// over and the sync thread exits.
+    /// over and the sync thread exits. Upcoming blocks are read and prepared
+    /// on the validation thread pool while earlier ones are appended.
     void Sync();
 
     /// Stops the instance from staying in sync with blockchain updates.
@@ -26,6 +26,7 @@
 
 #include <cerrno>
 #include <exception>
+#include <functional>
 #include <map>
 #include <optional>
 #include <stdexcept>
@@ -256,13 +257,15 @@ std::optional<uint256> BlockFilterIndex::ReadFilterHeader(int height, const uint
     return read_out.second.header;
 }
 
-bool BlockFilterIndex::CustomAppend(const interfaces::BlockInfo& block)
+std::function<bool()> BlockFilterIndex::CustomPrepare(const interfaces::BlockInfo& block)
 {
-    BlockFilter filter(m_filter_type, *Assert(block.data), *Assert(block.undo_data));
-    const uint256& header = filter.ComputeHeader(m_last_header);
-    bool res = Write(filter, block.height, header);
-    if (res) m_last_header = header; // update last header
-    return res;
+    // Building the filter only depends on the block, while its header chains on the previous one.
+    return [this, filter = BlockFilter(m_filter_type, *Assert(block.data), *Assert(block.undo_data)), height = block.height] {
+        const uint256& header = filter.ComputeHeader(m_last_header);
+        bool res = Write(filter, height, header);
+        if (res) m_last_header = header; // update last header
+        return res;
+    };
 }
 
 bool BlockFilterIndex::Write(const BlockFilter& filter, uint32_t block_height, const uint256& filter_header)
@@ -67,7 +67,7 @@ protected:
 
     bool CustomCommit(CDBBatch& batch) override;
 
-    bool CustomAppend(const interfaces::BlockInfo& block) override;
+    std::function<bool()> CustomPrepare(const interfaces::BlockInfo& block) override;
 
     bool CustomRemove(const interfaces::BlockInfo& block) override;
 
@@ -17,6 +17,7 @@
 #include <interfaces/chain.h>
 #include <interfaces/types.h>
 #include <kernel/coinstats.h>
+#include <node/context.h>
 #include <primitives/block.h>
 #include <primitives/transaction.h>
 #include <script/script.h>
@@ -36,6 +37,7 @@
 
 using kernel::ApplyCoinHash;
 using kernel::CCoinsStats;
+using kernel::CoinHashBatch;
 using kernel::GetBogoSize;
 using kernel::RemoveCoinHash;
 
@@ -121,6 +123,7 @@ bool CoinStatsIndex::CustomAppend(const interfaces::BlockInfo& block)
 
         // Add the new utxos created from the block
         assert(block.data);
+        CoinHashBatch muhash_batch{m_muhash, m_chain->context()->chainman->GetThreadPool().get()};
         for (size_t i = 0; i < block.data->vtx.size(); ++i) {
             const auto& tx{block.data->vtx.at(i)};
             const bool is_coinbase{tx->IsCoinBase()};
@@ -142,7 +145,7 @@ bool CoinStatsIndex::CustomAppend(const interfaces::BlockInfo& block)
                     continue;
                 }
 
-                ApplyCoinHash(m_muhash, outpoint, coin);
+                muhash_batch.Apply(outpoint, coin);
 
                 if (is_coinbase) {
                     m_total_coinbase_amount += coin.out.nValue;
@@ -163,7 +166,7 @@ bool CoinStatsIndex::CustomAppend(const interfaces::BlockInfo& block)
                     const Coin& coin{tx_undo.vprevout[j]};
                     const COutPoint outpoint{tx->vin[j].prevout.hash, tx->vin[j].prevout.n};
 
-                    RemoveCoinHash(m_muhash, outpoint, coin);
+                    muhash_batch.Remove(outpoint, coin);
 
                     m_total_prevout_spent_amount += coin.out.nValue;
 
@@ -173,6 +176,7 @@ bool CoinStatsIndex::CustomAppend(const interfaces::BlockInfo& block)
                 }
             }
         }
+        muhash_batch.Finish();
     } else {
         // genesis block
         m_total_unspendables_genesis_block += block_subsidy;
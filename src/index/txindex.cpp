@@ -24,6 +24,7 @@
 #include <cstdint>
 #include <cstdio>
 #include <exception>
+#include <functional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -71,10 +72,10 @@ TxIndex::TxIndex(std::unique_ptr<interfaces::Chain> chain, size_t n_cache_size,
 
 TxIndex::~TxIndex() = default;
 
-bool TxIndex::CustomAppend(const interfaces::BlockInfo& block)
+std::function<bool()> TxIndex::CustomPrepare(const interfaces::BlockInfo& block)
 {
     // Exclude genesis block transaction because outputs are not spendable.
-    if (block.height == 0) return true;
+    if (block.height == 0) return [] { return true; };
 
     assert(block.data);
     CDiskTxPos pos({block.file_number, block.data_pos}, GetSizeOfCompactSize(block.data->vtx.size()));
@@ -84,8 +85,10 @@ bool TxIndex::CustomAppend(const interfaces::BlockInfo& block)
         vPos.emplace_back(tx->GetHash(), pos);
         pos.nTxOffset += ::GetSerializeSize(TX_WITH_WITNESS(*tx));
     }
-    m_db->WriteTxs(vPos);
-    return true;
+    return [this, vPos = std::move(vPos)] {
+        m_db->WriteTxs(vPos);
+        return true;
+    };
 }
 
 BaseIndex::DB& TxIndex::GetDB() const { return *m_db; }
@@ -9,6 +9,7 @@
 #include <primitives/transaction.h>
 
 #include <cstddef>
+#include <functional>
 #include <memory>
 
 class uint256;
@@ -34,7 +35,7 @@ private:
     bool AllowPrune() const override { return false; }
 
 protected:
-    bool CustomAppend(const interfaces::BlockInfo& block) override;
+    std::function<bool()> CustomPrepare(const interfaces::BlockInfo& block) override;
 
     BaseIndex::DB& GetDB() const override;
 
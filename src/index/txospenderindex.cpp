@@ -26,6 +26,7 @@
 #include <cstddef>
 #include <cstdio>
 #include <exception>
+#include <functional>
 #include <ios>
 #include <span>
 #include <string>
@@ -129,10 +130,12 @@ static std::vector<std::pair<COutPoint, CDiskTxPos>> BuildSpenderPositions(const
 }
 
 
-bool TxoSpenderIndex::CustomAppend(const interfaces::BlockInfo& block)
+std::function<bool()> TxoSpenderIndex::CustomPrepare(const interfaces::BlockInfo& block)
 {
-    WriteSpenderInfos(BuildSpenderPositions(block));
-    return true;
+    return [this, items = BuildSpenderPositions(block)] {
+        WriteSpenderInfos(items);
+        return true;
+    };
 }
 
 bool TxoSpenderIndex::CustomRemove(const interfaces::BlockInfo& block)
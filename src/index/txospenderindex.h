@@ -12,6 +12,7 @@
 #include <util/expected.h>
 
 #include <cstddef>
+#include <functional>
 #include <cstdint>
 #include <memory>
 #include <optional>
@@ -46,7 +47,7 @@ private:
 protected:
     interfaces::Chain::NotifyOptions CustomOptions() override;
 
-    bool CustomAppend(const interfaces::BlockInfo& block) override;
+    std::function<bool()> CustomPrepare(const interfaces::BlockInfo& block) override;
 
     bool CustomRemove(const interfaces::BlockInfo& block) override;
 
@@ -16,6 +16,8 @@ class CChainParams;
 namespace kernel {
 
 static constexpr bool DEFAULT_XOR_BLOCKSDIR{true};
+/** Default for -blockcache, the memory limit in MiB of the cache of recently read blocks and undo data. */
+static constexpr int64_t DEFAULT_BLOCK_CACHE_MB{32};
 
 /**
  * An options struct for `BlockManager`, more ergonomically referred to as
@@ -26,6 +28,7 @@ struct BlockManagerOpts {
     bool use_xor{DEFAULT_XOR_BLOCKSDIR};
     uint64_t prune_target{0};
     bool fast_prune{false};
+    size_t block_cache_bytes{DEFAULT_BLOCK_CACHE_MB << 20};
     const fs::path blocks_dir;
     Notifications& notifications;
     DBParams block_tree_db_params;
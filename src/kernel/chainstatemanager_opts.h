@@ -23,6 +23,7 @@ class ValidationSignals;
 
 static constexpr auto DEFAULT_MAX_TIP_AGE{24h};
 static constexpr int32_t DEFAULT_PREVOUTFETCH_THREADS{8};
+static constexpr int32_t DEFAULT_BLOCK_LOOKAHEAD{2};
 
 namespace kernel {
 
@@ -49,6 +50,8 @@ struct ChainstateManagerOpts {
     int worker_threads_num{0};
     //! Number of worker threads used for prefetching block input prevouts. Zero means no parallel fetching.
     int32_t prevoutfetch_threads_num{DEFAULT_PREVOUTFETCH_THREADS};
+    //! Number of blocks read from disk and prepared ahead of the block being connected. Zero disables the lookahead.
+    int32_t block_lookahead{DEFAULT_BLOCK_LOOKAHEAD};
     size_t script_execution_cache_bytes{DEFAULT_SCRIPT_EXECUTION_CACHE_BYTES};
     size_t signature_cache_bytes{DEFAULT_SIGNATURE_CACHE_BYTES};
 };
@@ -19,6 +19,7 @@
 #include <util/check.h>
 #include <util/log.h>
 #include <util/overflow.h>
+#include <util/threadpool.h>
 #include <validation.h>
 
 #include <cstddef>
@@ -70,8 +71,73 @@ void RemoveCoinHash(MuHash3072& muhash, const COutPoint& outpoint, const Coin& c
     muhash.Remove(MakeUCharSpan(ss));
 }
 
+static void ApplyCoinHash(CoinHashBatch& batch, const COutPoint& outpoint, const Coin& coin)
+{
+    batch.Apply(outpoint, coin);
+}
+
 static void ApplyCoinHash(std::nullptr_t, const COutPoint& outpoint, const Coin& coin) {}
 
+static MuHash3072 HashBatch(const CoinHashBatch::Batch& batch)
+{
+    MuHash3072 muhash;
+    size_t begin{0};
+    for (const auto& [end, remove] : batch.coins) {
+        const std::span<const unsigned char> coin{batch.data.data() + begin, end - begin};
+        if (remove) {
+            muhash.Remove(coin);
+        } else {
+            muhash.Insert(coin);
+        }
+        begin = end;
+    }
+    return muhash;
+}
+
+CoinHashBatch::CoinHashBatch(MuHash3072& muhash, ThreadPool* thread_pool)
+    : m_muhash{muhash}, m_thread_pool{thread_pool}, m_batch{std::make_shared<Batch>()}
+{
+    // Keep every worker busy while the results of earlier batches are multiplied in.
+    if (m_thread_pool) m_max_pending = 2 * m_thread_pool->WorkersCount();
+    if (m_max_pending == 0) m_thread_pool = nullptr;
+}
+
+void CoinHashBatch::Add(const COutPoint& outpoint, const Coin& coin, bool remove)
+{
+    VectorWriter writer{m_batch->data, m_batch->data.size()};
+    TxOutSer(writer, outpoint, coin);
+    m_batch->coins.emplace_back(m_batch->data.size(), remove);
+    if (m_batch->coins.size() >= BATCH_SIZE) Submit();
+}
+
+void CoinHashBatch::Submit()
+{
+    if (m_batch->coins.empty()) return;
+    std::shared_ptr<const Batch> batch{std::exchange(m_batch, std::make_shared<Batch>())};
+    if (m_thread_pool) {
+        while (m_pending.size() >= m_max_pending) {
+            m_muhash *= m_pending.front().get();
+            m_pending.pop_front();
+        }
+        // The task owns its batch, so it may outlive this object.
+        auto task{m_thread_pool->Submit([batch] { return HashBatch(*batch); })};
+        if (task) {
+            m_pending.push_back(std::move(*task));
+            return;
+        }
+    }
+    m_muhash *= HashBatch(*batch);
+}
+
+void CoinHashBatch::Finish()
+{
+    Submit();
+    for (auto& pending : m_pending) {
+        m_muhash *= pending.get();
+    }
+    m_pending.clear();
+}
+
 //! Warning: be very careful when changing this! assumeutxo and UTXO snapshot
 //! validation commitments are reliant on the hash constructed by this
 //! function.
@@ -109,7 +175,7 @@ static void ApplyStats(CCoinsStats& stats, const std::map<uint32_t, Coin>& outpu
 
 //! Calculate statistics about the unspent transaction output set
 template <typename T>
-static std::optional<CCoinsStats> ComputeUTXOStats(T hash_obj, const CCoinsViewDB& view, node::BlockManager& blockman, const std::function<void()>& interruption_point)
+static std::optional<CCoinsStats> ComputeUTXOStats(T&& hash_obj, const CCoinsViewDB& view, node::BlockManager& blockman, const std::function<void()>& interruption_point)
 {
     std::unique_ptr<CCoinsViewCursor> pcursor;
     CBlockIndex* pindex;
@@ -152,7 +218,7 @@ static std::optional<CCoinsStats> ComputeUTXOStats(T hash_obj, const CCoinsViewD
     return stats;
 }
 
-std::optional<CCoinsStats> ComputeUTXOStats(CoinStatsHashType hash_type, const CCoinsViewDB& view, node::BlockManager& blockman, const std::function<void()>& interruption_point)
+std::optional<CCoinsStats> ComputeUTXOStats(CoinStatsHashType hash_type, const CCoinsViewDB& view, node::BlockManager& blockman, const std::function<void()>& interruption_point, ThreadPool* thread_pool)
 {
     return [&]() -> std::optional<CCoinsStats> {
         switch (hash_type) {
@@ -162,7 +228,8 @@ std::optional<CCoinsStats> ComputeUTXOStats(CoinStatsHashType hash_type, const C
         }
         case(CoinStatsHashType::MUHASH): {
             MuHash3072 muhash;
-            return ComputeUTXOStats(muhash, view, blockman, interruption_point);
+            CoinHashBatch batch{muhash, thread_pool};
+            return ComputeUTXOStats(batch, view, blockman, interruption_point);
         }
         case(CoinStatsHashType::NONE): {
             return ComputeUTXOStats(nullptr, view, blockman, interruption_point);
@@ -182,6 +249,11 @@ static void FinalizeHash(MuHash3072& muhash, CCoinsStats& stats)
     muhash.Finalize(out);
     stats.hashSerialized = out;
 }
+static void FinalizeHash(CoinHashBatch& batch, CCoinsStats& stats)
+{
+    batch.Finish();
+    FinalizeHash(batch.GetMuHash(), stats);
+}
 static void FinalizeHash(std::nullptr_t, CCoinsStats& stats) {}
 
 } // namespace kernel
@@ -7,17 +7,24 @@
 
 #include <arith_uint256.h>
 #include <consensus/amount.h>
+#include <crypto/muhash.h>
 #include <uint256.h>
 
+#include <cstddef>
 #include <cstdint>
+#include <deque>
 #include <functional>
+#include <future>
+#include <memory>
 #include <optional>
+#include <utility>
+#include <vector>
 
 class CCoinsViewDB;
 class Coin;
 class COutPoint;
 class CScript;
-class MuHash3072;
+class ThreadPool;
 namespace node {
 class BlockManager;
 } // namespace node
@@ -77,7 +84,49 @@ uint64_t GetBogoSize(const CScript& script_pub_key);
 void ApplyCoinHash(MuHash3072& muhash, const COutPoint& outpoint, const Coin& coin);
 void RemoveCoinHash(MuHash3072& muhash, const COutPoint& outpoint, const Coin& coin);
 
-std::optional<CCoinsStats> ComputeUTXOStats(CoinStatsHashType hash_type, const CCoinsViewDB& view, node::BlockManager& blockman, const std::function<void()>& interruption_point = {});
+/** Adds coins to and removes them from a MuHash3072 in batches.
+ *
+ * Since MuHash updates commute, each batch of coins can be hashed into a
+ * MuHash3072 of its own, which is then multiplied into the target. With a
+ * thread pool, the batches are hashed by its workers, so that only one
+ * multiplication per batch is left to the calling thread.
+ */
+class CoinHashBatch
+{
+public:
+    //! Number of coins hashed together in one task.
+    static constexpr size_t BATCH_SIZE{256};
+
+    /** Serialized coins, and for each the end of its data and whether it is removed. */
+    struct Batch {
+        std::vector<unsigned char> data;
+        std::vector<std::pair<size_t, bool>> coins;
+    };
+
+    CoinHashBatch(MuHash3072& muhash, ThreadPool* thread_pool);
+
+    void Apply(const COutPoint& outpoint, const Coin& coin) { Add(outpoint, coin, /*remove=*/false); }
+    void Remove(const COutPoint& outpoint, const Coin& coin) { Add(outpoint, coin, /*remove=*/true); }
+
+    /** Wait for all batches and multiply them into the MuHash3072. */
+    void Finish();
+
+    MuHash3072& GetMuHash() { return m_muhash; }
+
+private:
+    MuHash3072& m_muhash;
+    ThreadPool* m_thread_pool;
+    //! Maximum number of batches being hashed at once.
+    size_t m_max_pending{0};
+    std::shared_ptr<Batch> m_batch;
+    std::deque<std::future<MuHash3072>> m_pending;
+
+    void Add(const COutPoint& outpoint, const Coin& coin, bool remove);
+    void Submit();
+};
+
+/** Compute the UTXO set statistics. When a thread pool is given, MuHash hashing is spread over its workers. */
+std::optional<CCoinsStats> ComputeUTXOStats(CoinStatsHashType hash_type, const CCoinsViewDB& view, node::BlockManager& blockman, const std::function<void()>& interruption_point = {}, ThreadPool* thread_pool = nullptr);
 } // namespace kernel
 
 #endif // BITCOIN_KERNEL_COINSTATS_H
@@ -2132,7 +2132,7 @@ void CConnman::SocketHandler()
         // select(2)). If none are ready, wait for a short while and return
         // empty sets.
         events_per_sock = GenerateWaitSockets(snap.Nodes());
-        if (events_per_sock.empty() || !events_per_sock.begin()->first->WaitMany(timeout, events_per_sock)) {
+        if (events_per_sock.empty() || !m_sock_poller.WaitMany(timeout, events_per_sock)) {
             m_interrupt_net->sleep_for(timeout);
         }
 
@@ -2270,6 +2270,8 @@ void CConnman::ThreadSocketHandler()
         NotifyNumConnectionsChanged();
         SocketHandler();
     }
+    // Release the sockets of disconnected peers and listening sockets.
+    m_sock_poller.Clear();
 }
 
 void CConnman::WakeMessageHandler()
@@ -1743,6 +1743,12 @@ private:
      */
     const std::shared_ptr<CThreadInterrupt> m_interrupt_net;
 
+    /**
+     * Waits for readiness of the sockets in SocketHandler(). Only accessed by
+     * threadSocketHandler.
+     */
+    SockPoller m_sock_poller;
+
     /**
      * I2P SAM session.
      * Used to accept incoming and make outgoing I2P connections from a persistent
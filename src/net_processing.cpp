@@ -58,6 +58,7 @@
 #include <uint256.h>
 #include <util/check.h>
 #include <util/strencodings.h>
+#include <util/threadpool.h>
 #include <util/time.h>
 #include <util/trace.h>
 #include <validation.h>
@@ -391,6 +392,25 @@ struct Peer {
     /** Work queue of items requested by this peer **/
     std::deque<CInv> m_getdata_requests GUARDED_BY(m_getdata_requests_mutex);
 
+    /** A block requested by this peer that is being read from disk in the background. */
+    struct BlockRead {
+        uint256 hash;
+        std::future<node::BlockManager::ReadRawBlockResult> data;
+        /** Completes once the message handler has been woken up after the read. */
+        std::future<void> task;
+
+        BlockRead(const uint256& block_hash, std::future<node::BlockManager::ReadRawBlockResult> block_data, std::future<void> read_task)
+            : hash{block_hash}, data{std::move(block_data)}, task{std::move(read_task)} {}
+        ~BlockRead() { if (task.valid()) task.wait(); }
+    };
+    std::optional<BlockRead> m_block_read GUARDED_BY(NetEventsInterface::g_msgproc_mutex);
+
+    /** Whether the message handler has to wait for m_block_read before answering getdata requests. */
+    bool BlockReadPending() const EXCLUSIVE_LOCKS_REQUIRED(NetEventsInterface::g_msgproc_mutex)
+    {
+        return m_block_read && m_block_read->data.wait_for(0s) != std::future_status::ready;
+    }
+
     /** Time of the last getheaders message to this peer */
     NodeClock::time_point m_last_getheaders_timestamp GUARDED_BY(NetEventsInterface::g_msgproc_mutex){};
 
@@ -1030,6 +1050,13 @@ private:
     bool AlreadyHaveBlock(const uint256& block_hash) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
     void ProcessGetBlockData(CNode& pfrom, Peer& peer, const CInv& inv)
         EXCLUSIVE_LOCKS_REQUIRED(g_msgproc_mutex, !m_most_recent_block_mutex);
+    /**
+     * With Options::async_block_reads, start reading a block requested by the peer from disk
+     * on the validation thread pool. The message handler is woken up once it has been read.
+     * @return true if the block is still being read and the request must be answered later
+     */
+    bool MaybeReadBlockInBackground(Peer& peer, const CInv& inv)
+        EXCLUSIVE_LOCKS_REQUIRED(g_msgproc_mutex, !m_most_recent_block_mutex) LOCKS_EXCLUDED(::cs_main);
 
     /**
      * Validation logic for compact filters request handling.
@@ -2444,17 +2471,35 @@ void PeerManagerImpl::ProcessGetBlockData(CNode& pfrom, Peer& peer, const CInv&
     } else if (inv.IsMsgWitnessBlk()) {
         // Fast-path: in this case it is possible to serve the block directly from disk,
         // as the network format matches the format on disk
-        if (const auto block_data{m_chainman.m_blockman.ReadRawBlock(block_pos)}) {
-            MakeAndPushMessage(pfrom, NetMsgType::BLOCK, std::span{*block_data});
-        } else {
-            if (WITH_LOCK(m_chainman.GetMutex(), return m_chainman.m_blockman.IsBlockPruned(*pindex))) {
-                LogDebug(BCLog::NET, "Block was pruned before it could be read, %s", pfrom.DisconnectMsg());
-            } else {
-                LogError("Cannot load block from disk, %s", pfrom.DisconnectMsg());
+        bool sent{false};
+        if (!peer.m_block_read || peer.m_block_read->hash != inv.hash) {
+            // Copy the block from the mapped block file straight into the message.
+            if (const auto block_view{m_chainman.m_blockman.MapRawBlock(block_pos)}) {
+                CSerializedNetMsg msg;
+                msg.m_type = NetMsgType::BLOCK;
+                msg.data.resize(block_view->size());
+                block_view->CopyTo(MakeWritableByteSpan(msg.data));
+                m_connman.PushMessage(&pfrom, std::move(msg));
+                sent = true;
             }
-            pfrom.fDisconnect = true;
-            return;
         }
+        if (!sent) {
+            const auto block_data{peer.m_block_read && peer.m_block_read->hash == inv.hash ?
+                                      peer.m_block_read->data.get() :
+                                      m_chainman.m_blockman.ReadRawBlock(block_pos)};
+            if (!block_data) {
+                peer.m_block_read.reset();
+                if (WITH_LOCK(m_chainman.GetMutex(), return m_chainman.m_blockman.IsBlockPruned(*pindex))) {
+                    LogDebug(BCLog::NET, "Block was pruned before it could be read, %s", pfrom.DisconnectMsg());
+                } else {
+                    LogError("Cannot load block from disk, %s", pfrom.DisconnectMsg());
+                }
+                pfrom.fDisconnect = true;
+                return;
+            }
+            MakeAndPushMessage(pfrom, NetMsgType::BLOCK, std::span{*block_data});
+        }
+        peer.m_block_read.reset();
         // Don't set pblock as we've sent the block
     } else {
         // Send block from disk
@@ -2555,6 +2600,44 @@ CTransactionRef PeerManagerImpl::FindTxForGetData(const Peer::TxRelay& tx_relay,
     return {};
 }
 
+bool PeerManagerImpl::MaybeReadBlockInBackground(Peer& peer, const CInv& inv)
+{
+    // Only blocks in the on-disk format are read in the background.
+    if (!m_opts.async_block_reads || !inv.IsMsgWitnessBlk()) return false;
+
+    if (peer.m_block_read) {
+        if (peer.m_block_read->hash == inv.hash) return peer.BlockReadPending();
+        peer.m_block_read.reset();
+    }
+
+    if (WITH_LOCK(m_most_recent_block_mutex, return m_most_recent_block && m_most_recent_block->GetHash() == inv.hash)) {
+        return false;
+    }
+
+    FlatFilePos block_pos;
+    {
+        LOCK(cs_main);
+        const CBlockIndex* pindex{m_chainman.m_blockman.LookupBlockIndex(inv.hash)};
+        // Leave requests that are not served, or that need more than a read, to ProcessGetBlockData().
+        if (!pindex || !(pindex->nStatus & BLOCK_HAVE_DATA) || !pindex->IsValid(BLOCK_VALID_SCRIPTS) ||
+            !BlockRequestAllowed(*pindex)) {
+            return false;
+        }
+        block_pos = pindex->GetBlockPos();
+    }
+
+    std::promise<node::BlockManager::ReadRawBlockResult> promise;
+    auto data{promise.get_future()};
+    auto task{m_chainman.GetThreadPool()->Submit(
+        [&blockman = m_chainman.m_blockman, &connman = m_connman, block_pos, promise = std::move(promise)]() mutable {
+            promise.set_value(blockman.ReadRawBlock(block_pos));
+            connman.WakeMessageHandler();
+        })};
+    if (!task) return false;
+    peer.m_block_read.emplace(inv.hash, std::move(data), std::move(*task));
+    return true;
+}
+
 void PeerManagerImpl::ProcessGetData(CNode& pfrom, Peer& peer, const std::atomic<bool>& interruptMsgProc)
 {
     AssertLockNotHeld(cs_main);
@@ -2592,8 +2675,10 @@ void PeerManagerImpl::ProcessGetData(CNode& pfrom, Peer& peer, const std::atomic
     }
 
     // Only process one BLOCK item per call, since they're uncommon and can be
-    // expensive to process.
-    if (it != peer.m_getdata_requests.end() && !pfrom.fPauseSend) {
+    // expensive to process. Don't wait here for a block that is read in the
+    // background, the request is answered in a later call.
+    if (it != peer.m_getdata_requests.end() && !pfrom.fPauseSend &&
+        !(it->IsGenBlkMsg() && MaybeReadBlockInBackground(peer, *it))) {
         const CInv &inv = *it++;
         if (inv.IsGenBlkMsg()) {
             ProcessGetBlockData(pfrom, peer, inv);
@@ -5203,7 +5288,8 @@ bool PeerManagerImpl::ProcessMessages(CNode& node, std::atomic<bool>& interruptM
     // and prevents m_getdata_requests to grow unbounded
     {
         LOCK(peer.m_getdata_requests_mutex);
-        if (!peer.m_getdata_requests.empty()) return true;
+        // A background block read wakes up the message handler once it is done.
+        if (!peer.m_getdata_requests.empty()) return !peer.BlockReadPending();
     }
 
     // Don't bother if send buffer is too full to respond anyway
@@ -5236,7 +5322,7 @@ bool PeerManagerImpl::ProcessMessages(CNode& node, std::atomic<bool>& interruptM
         if (interruptMsgProc) return false;
         {
             LOCK(peer.m_getdata_requests_mutex);
-            if (!peer.m_getdata_requests.empty()) fMoreWork = true;
+            if (!peer.m_getdata_requests.empty() && !peer.BlockReadPending()) fMoreWork = true;
         }
         // Does this peer have an orphan ready to reconsider?
         // (Note: we may have provided a parent for an orphan provided
@@ -9,11 +9,14 @@
 #include <node/database_args.h>
 #include <tinyformat.h>
 #include <util/byte_units.h>
+#include <util/overflow.h>
 #include <util/result.h>
 #include <util/translation.h>
 #include <validation.h>
 
+#include <algorithm>
 #include <cstdint>
+#include <limits>
 
 namespace node {
 util::Result<void> ApplyArgsManOptions(const ArgsManager& args, BlockManager::Options& opts)
@@ -36,6 +39,13 @@ util::Result<void> ApplyArgsManOptions(const ArgsManager& args, BlockManager::Op
 
     if (auto value{args.GetBoolArg("-fastprune")}) opts.fast_prune = *value;
 
+    if (auto value{args.GetIntArg("-blockcache")}) {
+        if (*value < 0) {
+            return util::Error{Untranslated(strprintf("-blockcache must be non-negative (got %d). Use 0 to disable the block cache.", *value))};
+        }
+        opts.block_cache_bytes = std::min<uint64_t>(SaturatingLeftShift<uint64_t>(*value, 20), std::numeric_limits<size_t>::max());
+    }
+
     ReadDatabaseArgs(args, opts.block_tree_db_params.options);
 
     return {};
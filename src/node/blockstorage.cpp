@@ -6,7 +6,9 @@
 
 #include <arith_uint256.h>
 #include <chain.h>
+#include <coins.h>
 #include <consensus/params.h>
+#include <core_memusage.h>
 #include <crypto/hex_base.h>
 #include <dbwrapper.h>
 #include <flatfile.h>
@@ -16,6 +18,7 @@
 #include <kernel/messagestartchars.h>
 #include <kernel/notifications_interface.h>
 #include <kernel/types.h>
+#include <memusage.h>
 #include <pow.h>
 #include <primitives/block.h>
 #include <primitives/transaction.h>
@@ -45,6 +48,7 @@
 #include <compare>
 #include <cstddef>
 #include <cstdio>
+#include <cstring>
 #include <exception>
 #include <map>
 #include <optional>
@@ -54,6 +58,13 @@
 #include <system_error>
 #include <unordered_map>
 
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace kernel {
 static constexpr uint8_t DB_BLOCK_FILES{'f'};
 static constexpr uint8_t DB_BLOCK_INDEX{'b'};
@@ -712,9 +723,129 @@ CBlockFileInfo* BlockManager::GetBlockFileInfo(size_t n)
     return &m_blockfile_info.at(n);
 }
 
+static size_t BlockUndoUsage(const CBlockUndo& blockundo)
+{
+    size_t usage{memusage::DynamicUsage(blockundo.vtxundo)};
+    for (const CTxUndo& txundo : blockundo.vtxundo) {
+        usage += memusage::DynamicUsage(txundo.vprevout);
+        for (const Coin& coin : txundo.vprevout) usage += coin.DynamicMemoryUsage();
+    }
+    return usage;
+}
+
+/**
+ * Cached data is only served while its file is still there, so that a missing
+ * block or undo file is noticed the same way with or without the cache.
+ */
+static bool FileExists(const FlatFileSeq& seq, const FlatFilePos& pos)
+{
+    std::error_code ec;
+    return std::filesystem::exists(seq.FileName(pos), ec);
+}
+
+std::shared_ptr<const CBlock> RecentBlockCache::GetBlock(const uint256& hash)
+{
+    if (m_max_usage == 0) return nullptr;
+    LOCK(m_mutex);
+    const auto it{m_blocks.find(hash)};
+    if (it == m_blocks.end()) {
+        ++m_block_misses;
+        return nullptr;
+    }
+    ++m_block_hits;
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    return it->second->block;
+}
+
+std::shared_ptr<const CBlockUndo> RecentBlockCache::GetUndo(const uint256& hash)
+{
+    if (m_max_usage == 0) return nullptr;
+    LOCK(m_mutex);
+    const auto it{m_undos.find(hash)};
+    if (it == m_undos.end()) {
+        ++m_undo_misses;
+        return nullptr;
+    }
+    ++m_undo_hits;
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    return it->second->undo;
+}
+
+void RecentBlockCache::AddBlock(const uint256& hash, int file, std::shared_ptr<const CBlock> block)
+{
+    if (m_max_usage == 0) return;
+    const size_t usage{RecursiveDynamicUsage(*block)};
+    LOCK(m_mutex);
+    Add(m_blocks, Entry{.hash = hash, .file = file, .usage = usage, .block = std::move(block), .undo = nullptr});
+}
+
+void RecentBlockCache::AddUndo(const uint256& hash, int file, std::shared_ptr<const CBlockUndo> undo)
+{
+    if (m_max_usage == 0) return;
+    const size_t usage{BlockUndoUsage(*undo)};
+    LOCK(m_mutex);
+    Add(m_undos, Entry{.hash = hash, .file = file, .usage = usage, .block = nullptr, .undo = std::move(undo)});
+}
+
+void RecentBlockCache::Add(EntryMap& map, Entry entry)
+{
+    AssertLockHeld(m_mutex);
+    if (entry.usage > m_max_usage) return;
+    // Another thread may have read the same data concurrently.
+    if (const auto it{map.find(entry.hash)}; it != map.end()) Erase(it->second);
+    while (m_usage + entry.usage > m_max_usage) Erase(std::prev(m_entries.end()));
+
+    m_usage += entry.usage;
+    const uint256 hash{entry.hash};
+    m_entries.push_front(std::move(entry));
+    map.emplace(hash, m_entries.begin());
+}
+
+void RecentBlockCache::Erase(EntryList::iterator it)
+{
+    AssertLockHeld(m_mutex);
+    (it->block ? m_blocks : m_undos).erase(it->hash);
+    m_usage -= it->usage;
+    m_entries.erase(it);
+}
+
+void RecentBlockCache::EraseFiles(const std::set<int>& files)
+{
+    LOCK(m_mutex);
+    for (auto it{m_entries.begin()}; it != m_entries.end();) {
+        const auto next{std::next(it)};
+        if (files.contains(it->file)) Erase(it);
+        it = next;
+    }
+}
+
+RecentBlockCacheStats RecentBlockCache::GetStats() const
+{
+    LOCK(m_mutex);
+    return {
+        .block_hits = m_block_hits,
+        .block_misses = m_block_misses,
+        .undo_hits = m_undo_hits,
+        .undo_misses = m_undo_misses,
+        .blocks = m_blocks.size(),
+        .undos = m_undos.size(),
+        .usage = m_usage,
+        .max_usage = m_max_usage,
+    };
+}
+
 bool BlockManager::ReadBlockUndo(CBlockUndo& blockundo, const CBlockIndex& index) const
 {
     const FlatFilePos pos{WITH_LOCK(::cs_main, return index.GetUndoPos())};
+    return ReadBlockUndo(blockundo, index, pos);
+}
+
+bool BlockManager::ReadBlockUndo(CBlockUndo& blockundo, const CBlockIndex& index, const FlatFilePos& pos) const
+{
+    if (const auto cached{m_block_cache.GetUndo(index.GetBlockHash())}; cached && FileExists(m_undo_file_seq, pos)) {
+        blockundo = *cached;
+        return true;
+    }
 
     // Open history file to read
     AutoFile file{OpenUndoFile(pos, true)};
@@ -744,6 +875,7 @@ bool BlockManager::ReadBlockUndo(CBlockUndo& blockundo, const CBlockIndex& index
         return false;
     }
 
+    m_block_cache.AddUndo(index.GetBlockHash(), pos.nFile, std::make_shared<const CBlockUndo>(blockundo));
     return true;
 }
 
@@ -820,8 +952,11 @@ uint64_t BlockManager::CalculateCurrentUsage()
 
 void BlockManager::UnlinkPrunedFiles(const std::set<int>& setFilesToPrune) const
 {
+    m_block_cache.EraseFiles(setFilesToPrune);
     std::error_code ec;
     for (std::set<int>::iterator it = setFilesToPrune.begin(); it != setFilesToPrune.end(); ++it) {
+        // Views that are still in use keep their mapping of the deleted file alive.
+        WITH_LOCK(m_mapped_files_mutex, m_mapped_files.erase(*it));
         FlatFilePos pos(*it, 0);
         const bool removed_blockfile{fs::remove(m_block_file_seq.FileName(pos), ec)};
         const bool removed_undofile{fs::remove(m_undo_file_seq.FileName(pos), ec)};
@@ -1049,6 +1184,13 @@ bool BlockManager::WriteBlockUndo(const CBlockUndo& blockundo, BlockValidationSt
 
 bool BlockManager::ReadBlock(CBlock& block, const FlatFilePos& pos, const std::optional<uint256>& expected_hash) const
 {
+    if (expected_hash) {
+        if (const auto cached{m_block_cache.GetBlock(*expected_hash)}; cached && FileExists(m_block_file_seq, pos)) {
+            block = *cached;
+            return true;
+        }
+    }
+
     block.SetNull();
 
     // Open history file to read
@@ -1085,6 +1227,7 @@ bool BlockManager::ReadBlock(CBlock& block, const FlatFilePos& pos, const std::o
         return false;
     }
 
+    if (expected_hash) m_block_cache.AddBlock(block_hash, pos.nFile, std::make_shared<const CBlock>(block));
     return true;
 }
 
@@ -1145,6 +1288,134 @@ BlockManager::ReadRawBlockResult BlockManager::ReadRawBlock(const FlatFilePos& p
     }
 }
 
+/** A read-only mapping of a whole block file. */
+class MappedBlockFile
+{
+public:
+    MappedBlockFile(const std::byte* data, size_t size, uint64_t dev, uint64_t ino)
+        : m_data{data}, m_size{size}, m_dev{dev}, m_ino{ino} {}
+    ~MappedBlockFile()
+    {
+#ifndef WIN32
+        munmap(const_cast<std::byte*>(m_data), m_size);
+#endif
+    }
+    MappedBlockFile(const MappedBlockFile&) = delete;
+    MappedBlockFile& operator=(const MappedBlockFile&) = delete;
+
+    std::span<const std::byte> Data() const { return {m_data, m_size}; }
+
+    //! Whether this is a mapping of the file with the given device and inode numbers.
+    bool IsFile(uint64_t dev, uint64_t ino) const { return m_dev == dev && m_ino == ino; }
+
+private:
+    const std::byte* const m_data;
+    const size_t m_size;
+    const uint64_t m_dev;
+    const uint64_t m_ino;
+};
+
+void RawBlockView::CopyTo(std::span<std::byte> dest) const
+{
+    assert(dest.size() == m_stored.size());
+    std::memcpy(dest.data(), m_stored.data(), m_stored.size());
+    m_obfuscation(dest, m_file_offset);
+}
+
+/** Maximum number of block files that are kept mapped by MapRawBlock(). */
+static constexpr size_t MAX_MAPPED_BLOCK_FILES{64};
+
+std::shared_ptr<const MappedBlockFile> BlockManager::MapBlockFile(int file_num, size_t min_size) const
+{
+#ifdef WIN32
+    return nullptr;
+#else
+    // Keep 32-bit systems from running out of address space.
+    if constexpr (sizeof(void*) < 8) return nullptr;
+
+    LOCK(m_mapped_files_mutex);
+    // Like ReadRawBlock(), only serve the file that is currently at the path of the block file.
+    const fs::path path{m_block_file_seq.FileName(FlatFilePos{file_num, 0})};
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) {
+        m_mapped_files.erase(file_num);
+        return nullptr;
+    }
+    if (const auto it{m_mapped_files.find(file_num)}; it != m_mapped_files.end() &&
+        it->second->IsFile(st.st_dev, st.st_ino) && it->second->Data().size() >= min_size) {
+        return it->second;
+    }
+
+    // The file is not mapped yet, was replaced, or grew since it was mapped.
+    const int fd{open(path.c_str(), O_RDONLY | O_CLOEXEC)};
+    if (fd == -1) return nullptr;
+    void* addr{MAP_FAILED};
+    if (fstat(fd, &st) == 0 && st.st_size > 0 && size_t(st.st_size) >= min_size) {
+        addr = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (addr == MAP_FAILED) return nullptr;
+
+    auto file{std::make_shared<const MappedBlockFile>(static_cast<const std::byte*>(addr), size_t(st.st_size), st.st_dev, st.st_ino)};
+    if (m_mapped_files.size() >= MAX_MAPPED_BLOCK_FILES && !m_mapped_files.contains(file_num)) {
+        // Blocks are mostly requested in ascending order, drop the lowest mapped file.
+        m_mapped_files.erase(std::ranges::min_element(m_mapped_files, {}, [](const auto& entry) { return entry.first; }));
+    }
+    m_mapped_files.insert_or_assign(file_num, file);
+    return file;
+#endif
+}
+
+BlockManager::MapRawBlockResult BlockManager::MapRawBlock(const FlatFilePos& pos, std::optional<std::pair<size_t, size_t>> block_part) const
+{
+    if (pos.nPos < STORAGE_HEADER_BYTES) {
+        LogError("Failed for %s while mapping raw block storage header", pos.ToString());
+        return util::Unexpected{ReadRawError::IO};
+    }
+    const auto file{MapBlockFile(pos.nFile, pos.nPos)};
+    if (!file) return util::Unexpected{ReadRawError::IO};
+    const auto data{file->Data()};
+
+    std::array<std::byte, STORAGE_HEADER_BYTES> header;
+    const size_t header_pos{pos.nPos - STORAGE_HEADER_BYTES};
+    std::ranges::copy(data.subspan(header_pos, STORAGE_HEADER_BYTES), header.begin());
+    m_obfuscation(header, header_pos);
+
+    MessageStartChars blk_start;
+    unsigned int blk_size;
+    SpanReader{header} >> blk_start >> blk_size;
+
+    if (blk_start != GetParams().MessageStart()) {
+        LogError("Block magic mismatch for %s: %s versus expected %s while mapping raw block",
+            pos.ToString(), HexStr(blk_start), HexStr(GetParams().MessageStart()));
+        return util::Unexpected{ReadRawError::IO};
+    }
+    if (blk_size > MAX_SIZE) {
+        LogError("Block data is larger than maximum deserialization size for %s: %s versus %s while mapping raw block",
+            pos.ToString(), blk_size, MAX_SIZE);
+        return util::Unexpected{ReadRawError::IO};
+    }
+
+    size_t offset{pos.nPos};
+    size_t size{blk_size};
+    if (block_part) {
+        const auto [part_offset, part_size]{*block_part};
+        if (part_size == 0 || SaturatingAdd(part_offset, part_size) > blk_size) {
+            return util::Unexpected{ReadRawError::BadPartRange}; // Avoid logging - offset/size come from untrusted REST input
+        }
+        offset += part_offset;
+        size = part_size;
+    }
+
+    if (offset + size > data.size()) {
+        // The block was written after the file was mapped, map it again.
+        const auto remapped{MapBlockFile(pos.nFile, offset + size)};
+        if (!remapped) return util::Unexpected{ReadRawError::IO};
+        return RawBlockView{remapped, remapped->Data().subspan(offset, size), offset, m_obfuscation};
+    }
+    return RawBlockView{file, data.subspan(offset, size), offset, m_obfuscation};
+}
+
 FlatFilePos BlockManager::WriteBlock(const CBlock& block, int nHeight)
 {
     AssertLockHeld(::cs_main);
@@ -1242,6 +1513,7 @@ BlockManager::BlockManager(const util::SignalInterrupt& interrupt, Options opts)
       m_opts{std::move(opts)},
       m_block_file_seq{FlatFileSeq{m_opts.blocks_dir, "blk", m_opts.fast_prune ? 0x4000 /* 16kB */ : BLOCKFILE_CHUNK_SIZE}},
       m_undo_file_seq{FlatFileSeq{m_opts.blocks_dir, "rev", UNDOFILE_CHUNK_SIZE}},
+      m_block_cache{m_opts.block_cache_bytes},
       m_interrupt{interrupt}
 {
     m_block_tree_db = std::make_unique<BlockTreeDB>(m_opts.block_tree_db_params);
@@ -34,6 +34,7 @@
 #include <functional>
 #include <iosfwd>
 #include <limits>
+#include <list>
 #include <map>
 #include <memory>
 #include <optional>
@@ -185,6 +186,100 @@ enum class ReadRawError {
     BadPartRange,
 };
 
+class MappedBlockFile;
+
+/**
+ * Serialized block data (or a part of it) inside a memory-mapped block file.
+ * Keeps the mapping alive, so it can be handed to the code sending the data
+ * without first copying it into a buffer.
+ */
+class RawBlockView
+{
+public:
+    RawBlockView(std::shared_ptr<const MappedBlockFile> file, std::span<const std::byte> stored, size_t file_offset, const Obfuscation& obfuscation)
+        : m_file{std::move(file)}, m_stored{stored}, m_file_offset{file_offset}, m_obfuscation{obfuscation} {}
+
+    size_t size() const { return m_stored.size(); }
+
+    //! Whether the stored data differs from the block data because the block files are obfuscated.
+    bool IsObfuscated() const { return bool{m_obfuscation}; }
+
+    //! The data as stored in the block file. Equal to the block data only if !IsObfuscated().
+    std::span<const std::byte> Stored() const { return m_stored; }
+
+    //! Copy the block data to dest, which must be size() bytes, removing the obfuscation.
+    void CopyTo(std::span<std::byte> dest) const;
+
+private:
+    std::shared_ptr<const MappedBlockFile> m_file;
+    std::span<const std::byte> m_stored;
+    size_t m_file_offset;
+    Obfuscation m_obfuscation;
+};
+
+/** Counters of a RecentBlockCache, as reported by the getblockcacheinfo RPC. */
+struct RecentBlockCacheStats {
+    uint64_t block_hits{0};
+    uint64_t block_misses{0};
+    uint64_t undo_hits{0};
+    uint64_t undo_misses{0};
+    size_t blocks{0};
+    size_t undos{0};
+    size_t usage{0};
+    size_t max_usage{0};
+};
+
+/**
+ * Size-bounded cache of recently read blocks and undo data, keyed by block
+ * hash. Entries are evicted in least-recently-used order once their total
+ * memory usage exceeds the limit. A limit of 0 disables the cache.
+ */
+class RecentBlockCache
+{
+public:
+    explicit RecentBlockCache(size_t max_usage) : m_max_usage{max_usage} {}
+
+    std::shared_ptr<const CBlock> GetBlock(const uint256& hash) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    std::shared_ptr<const CBlockUndo> GetUndo(const uint256& hash) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+    //! Add data read from block (or undo) file number file, evicting older entries if needed.
+    void AddBlock(const uint256& hash, int file, std::shared_ptr<const CBlock> block) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    void AddUndo(const uint256& hash, int file, std::shared_ptr<const CBlockUndo> undo) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+    //! Drop all entries that were read from the given files, e.g. because they are pruned.
+    void EraseFiles(const std::set<int>& files) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+    RecentBlockCacheStats GetStats() const EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+private:
+    struct Entry {
+        uint256 hash;
+        int file;
+        size_t usage;
+        //! Exactly one of block and undo is set.
+        std::shared_ptr<const CBlock> block;
+        std::shared_ptr<const CBlockUndo> undo;
+    };
+    using EntryList = std::list<Entry>;
+    using EntryMap = std::unordered_map<uint256, EntryList::iterator, BlockHasher>;
+
+    const size_t m_max_usage;
+
+    mutable Mutex m_mutex;
+    //! All entries, most recently used first.
+    EntryList m_entries GUARDED_BY(m_mutex);
+    EntryMap m_blocks GUARDED_BY(m_mutex);
+    EntryMap m_undos GUARDED_BY(m_mutex);
+    size_t m_usage GUARDED_BY(m_mutex){0};
+    uint64_t m_block_hits GUARDED_BY(m_mutex){0};
+    uint64_t m_block_misses GUARDED_BY(m_mutex){0};
+    uint64_t m_undo_hits GUARDED_BY(m_mutex){0};
+    uint64_t m_undo_misses GUARDED_BY(m_mutex){0};
+
+    void Add(EntryMap& map, Entry entry) EXCLUSIVE_LOCKS_REQUIRED(m_mutex);
+    void Erase(EntryList::iterator it) EXCLUSIVE_LOCKS_REQUIRED(m_mutex);
+};
+
 /**
  * Maintains a tree of blocks (stored in `m_block_index`) which is consulted
  * to determine where the most-work tip is.
@@ -306,6 +401,19 @@ private:
     const FlatFileSeq m_block_file_seq;
     const FlatFileSeq m_undo_file_seq;
 
+    /** Block files mapped by MapRawBlock(), by file number. */
+    mutable Mutex m_mapped_files_mutex;
+    mutable std::unordered_map<int, std::shared_ptr<const MappedBlockFile>> m_mapped_files GUARDED_BY(m_mapped_files_mutex);
+
+    /**
+     * Return a mapping of the block file that covers at least the first min_size bytes,
+     * or nullptr if the file could not be mapped.
+     */
+    std::shared_ptr<const MappedBlockFile> MapBlockFile(int file_num, size_t min_size) const EXCLUSIVE_LOCKS_REQUIRED(!m_mapped_files_mutex);
+
+    /** Blocks and undo data recently returned by ReadBlock() and ReadBlockUndo(). */
+    mutable RecentBlockCache m_block_cache;
+
 protected:
     std::vector<CBlockFileInfo> m_blockfile_info;
 
@@ -318,6 +426,7 @@ protected:
 public:
     using Options = kernel::BlockManagerOpts;
     using ReadRawBlockResult = util::Expected<std::vector<std::byte>, ReadRawError>;
+    using MapRawBlockResult = util::Expected<RawBlockView, ReadRawError>;
 
     explicit BlockManager(const util::SignalInterrupt& interrupt, Options opts);
 
@@ -470,14 +579,28 @@ public:
     /**
      *  Actually unlink the specified files
      */
-    void UnlinkPrunedFiles(const std::set<int>& setFilesToPrune) const;
+    void UnlinkPrunedFiles(const std::set<int>& setFilesToPrune) const EXCLUSIVE_LOCKS_REQUIRED(!m_mapped_files_mutex);
 
-    /** Functions for disk access for blocks */
+    /**
+     * Functions for disk access for blocks. Blocks read with an expected hash, and undo
+     * data, are served from the recent block cache if present, and added to it otherwise.
+     */
     bool ReadBlock(CBlock& block, const FlatFilePos& pos, const std::optional<uint256>& expected_hash) const;
     bool ReadBlock(CBlock& block, const CBlockIndex& index) const;
     ReadRawBlockResult ReadRawBlock(const FlatFilePos& pos, std::optional<std::pair<size_t, size_t>> block_part = std::nullopt) const;
+    /**
+     * Like ReadRawBlock(), but return a view into the memory-mapped block file instead of a copy.
+     * Fails with ReadRawError::IO if block files can not be mapped on this platform, in which case
+     * callers should fall back to ReadRawBlock().
+     */
+    MapRawBlockResult MapRawBlock(const FlatFilePos& pos, std::optional<std::pair<size_t, size_t>> block_part = std::nullopt) const
+        EXCLUSIVE_LOCKS_REQUIRED(!m_mapped_files_mutex);
 
     bool ReadBlockUndo(CBlockUndo& blockundo, const CBlockIndex& index) const;
+    /** Read undo data at pos, as returned by index.GetUndoPos(), without taking cs_main. */
+    bool ReadBlockUndo(CBlockUndo& blockundo, const CBlockIndex& index, const FlatFilePos& pos) const;
+
+    RecentBlockCacheStats GetBlockCacheStats() const { return m_block_cache.GetStats(); }
 
     void CleanupBlockRevFiles() const;
 };
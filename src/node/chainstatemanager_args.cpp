@@ -67,6 +67,13 @@ util::Result<void> ApplyArgsManOptions(const ArgsManager& args, ChainstateManage
         opts.prevoutfetch_threads_num = std::min(*value, MAX_PREVOUTFETCH_THREADS);
     }
 
+    if (auto value{args.GetArg<int32_t>("-blocklookahead")}) {
+        if (*value < 0) {
+            return util::Error{Untranslated(strprintf("-blocklookahead must be non-negative (got %d). Use 0 to disable the block lookahead.", *value))};
+        }
+        opts.block_lookahead = std::min(*value, MAX_BLOCK_LOOKAHEAD);
+    }
+
     if (auto max_size = args.GetIntArg("-maxsigcachesize")) {
         // 1. When supplied with a max_size of 0, both the signature cache and
         //    script execution cache create the minimum possible cache (2
@@ -12,5 +12,6 @@ void ReadCoinsViewArgs(const ArgsManager& args, CoinsViewOptions& options)
 {
     if (auto value = args.GetIntArg("-dbbatchsize")) options.batch_write_bytes = *value;
     if (auto value = args.GetIntArg("-dbcrashratio")) options.simulate_crash_ratio = *value;
+    options.background_flush = args.GetBoolArg("-dbbackgroundflush", options.background_flush);
 }
 } // namespace node
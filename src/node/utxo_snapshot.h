@@ -9,6 +9,7 @@
 #include <kernel/chainparams.h>
 #include <kernel/cs_main.h>
 #include <kernel/messagestartchars.h>
+#include <serialize.h>
 #include <sync.h>
 #include <tinyformat.h>
 #include <uint256.h>
@@ -23,6 +24,7 @@
 #include <set>
 #include <string>
 #include <string_view>
+#include <vector>
 
 // UTXO set snapshot magic bytes
 static constexpr std::array<uint8_t, 5> SNAPSHOT_MAGIC_BYTES = {'u', 't', 'x', 'o', 0xff};
@@ -37,9 +39,14 @@ namespace node {
 class SnapshotMetadata
 {
     inline static const uint16_t VERSION{2};
-    const std::set<uint16_t> m_supported_versions{VERSION};
+    //! Version in which the coins are stored in hashed chunks, see SnapshotChunk.
+    inline static const uint16_t CHUNKED_VERSION{3};
+    const std::set<uint16_t> m_supported_versions{VERSION, CHUNKED_VERSION};
     const MessageStartChars m_network_magic;
 public:
+    //! The format version of the coins following the metadata.
+    uint16_t m_version{VERSION};
+
     //! The hash of the block that reflects the tip of the chain for the
     //! UTXO set contained in this snapshot.
     uint256 m_base_blockhash;
@@ -55,15 +62,19 @@ public:
     SnapshotMetadata(
         const MessageStartChars network_magic,
         const uint256& base_blockhash,
-        uint64_t coins_count) :
+        uint64_t coins_count,
+        bool chunked = false) :
             m_network_magic(network_magic),
+            m_version(chunked ? CHUNKED_VERSION : VERSION),
             m_base_blockhash(base_blockhash),
             m_coins_count(coins_count) { }
 
+    bool IsChunked() const { return m_version == CHUNKED_VERSION; }
+
     template <typename Stream>
     inline void Serialize(Stream& s) const {
         s << SNAPSHOT_MAGIC_BYTES;
-        s << VERSION;
+        s << m_version;
         s << m_network_magic;
         s << m_base_blockhash;
         s << m_coins_count;
@@ -84,6 +95,7 @@ public:
         if (!m_supported_versions.contains(version)) {
             throw std::ios_base::failure(strprintf("Version of snapshot %s does not match any of the supported versions.", version));
         }
+        m_version = version;
 
         // Read the network magic (pchMessageStart)
         MessageStartChars message;
@@ -105,6 +117,21 @@ public:
     }
 };
 
+//! Serialized size after which a chunk of a chunked snapshot is completed.
+static constexpr size_t SNAPSHOT_CHUNK_TARGET_SIZE{2 << 20};
+
+//! A chunk of coins in a chunked snapshot. The coins are serialized like in
+//! unchunked snapshots, grouped by txid, and the coins of one txid are never
+//! split across chunks. The hash commits to the serialized coins, so that
+//! each chunk can be checked and deserialized independently of the others.
+struct SnapshotChunk {
+    uint64_t coins_count{0};
+    std::vector<std::byte> data;
+    uint256 hash;
+
+    SERIALIZE_METHODS(SnapshotChunk, obj) { READWRITE(COMPACTSIZE(obj.coins_count), obj.data, obj.hash); }
+};
+
 //! The file in the snapshot chainstate dir which stores the base blockhash. This is
 //! needed to reconstruct snapshot chainstates on init.
 //!
@@ -92,9 +92,20 @@ public:
         *(static_cast<CBlockHeader*>(this)) = header;
     }
 
-    SERIALIZE_METHODS(CBlock, obj)
+    template <typename Stream>
+    void Serialize(Stream& s) const
     {
-        READWRITE(AsBase<CBlockHeader>(obj), obj.vtx);
+        s << AsBase<CBlockHeader>(*this) << vtx;
+    }
+
+    template <typename Stream>
+    void Unserialize(Stream& s)
+    {
+        // Read the transactions in mutable form first, so that their hashes
+        // can be computed together.
+        std::vector<CMutableTransaction> txs;
+        s >> AsBase<CBlockHeader>(*this) >> txs;
+        vtx = MakeTransactionRefs(std::move(txs));
     }
 
     void SetNull()
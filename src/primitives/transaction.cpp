@@ -7,6 +7,7 @@
 
 #include <consensus/amount.h>
 #include <crypto/hex_base.h>
+#include <crypto/sha256.h>
 #include <hash.h>
 #include <primitives/transaction_identifier.h>
 #include <script/script.h>
@@ -17,6 +18,7 @@
 #include <cassert>
 #include <span>
 #include <stdexcept>
+#include <utility>
 
 std::string COutPoint::ToString() const
 {
@@ -94,6 +96,62 @@ Wtxid CTransaction::ComputeWitnessHash() const
 
 CTransaction::CTransaction(const CMutableTransaction& tx) : vin(tx.vin), vout(tx.vout), version{tx.version}, nLockTime{tx.nLockTime}, m_has_witness{ComputeHasWitness()}, hash{ComputeHash()}, m_witness_hash{ComputeWitnessHash()} {}
 CTransaction::CTransaction(CMutableTransaction&& tx) : vin(std::move(tx.vin)), vout(std::move(tx.vout)), version{tx.version}, nLockTime{tx.nLockTime}, m_has_witness{ComputeHasWitness()}, hash{ComputeHash()}, m_witness_hash{ComputeWitnessHash()} {}
+CTransaction::CTransaction(PrecomputedHashes, CMutableTransaction&& tx, const Txid& txid, const Wtxid& wtxid) : vin(std::move(tx.vin)), vout(std::move(tx.vout)), version{tx.version}, nLockTime{tx.nLockTime}, m_has_witness{ComputeHasWitness()}, hash{txid}, m_witness_hash{wtxid} {}
+
+namespace {
+/** Minimal stream appending serialized data to a byte vector. */
+class ByteVectorWriter
+{
+    std::vector<unsigned char>& m_data;
+
+public:
+    explicit ByteVectorWriter(std::vector<unsigned char>& data) : m_data{data} {}
+    void write(std::span<const std::byte> src) { m_data.insert(m_data.end(), UCharCast(src.data()), UCharCast(src.data() + src.size())); }
+    template <typename T>
+    ByteVectorWriter& operator<<(const T& obj)
+    {
+        ::Serialize(*this, obj);
+        return *this;
+    }
+};
+} // namespace
+
+std::vector<CTransactionRef> MakeTransactionRefs(std::vector<CMutableTransaction>&& txs)
+{
+    if (txs.empty()) return {};
+
+    // Serialize all transactions without witness, followed by the ones that
+    // have a witness again with it, and hash all of them in one batch.
+    std::vector<unsigned char> buffer;
+    std::vector<size_t> offsets{0};
+    for (const auto& tx : txs) {
+        ByteVectorWriter{buffer} << TX_NO_WITNESS(tx);
+        offsets.push_back(buffer.size());
+    }
+    std::vector<size_t> wtxid_index(txs.size());
+    for (size_t i = 0; i < txs.size(); ++i) {
+        wtxid_index[i] = i;
+        if (!txs[i].HasWitness()) continue;
+        wtxid_index[i] = offsets.size() - 1;
+        ByteVectorWriter{buffer} << TX_WITH_WITNESS(txs[i]);
+        offsets.push_back(buffer.size());
+    }
+    std::vector<std::span<const unsigned char>> inputs;
+    inputs.reserve(offsets.size() - 1);
+    for (size_t i = 0; i + 1 < offsets.size(); ++i) {
+        inputs.emplace_back(buffer.data() + offsets[i], offsets[i + 1] - offsets[i]);
+    }
+    std::vector<uint256> hashes(inputs.size());
+    SHA256DMulti(hashes[0].begin(), inputs);
+
+    std::vector<CTransactionRef> ret;
+    ret.reserve(txs.size());
+    for (size_t i = 0; i < txs.size(); ++i) {
+        ret.push_back(std::make_shared<const CTransaction>(CTransaction::PrecomputedHashes{}, std::move(txs[i]),
+                                                           Txid::FromUint256(hashes[i]), Wtxid::FromUint256(hashes[wtxid_index[i]])));
+    }
+    return ret;
+}
 
 CAmount CTransaction::GetValueOut() const
 {
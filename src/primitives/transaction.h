@@ -304,10 +304,18 @@ private:
 
     bool ComputeHasWitness() const;
 
+    /** Tag restricting construction from precomputed hashes to MakeTransactionRefs. */
+    struct PrecomputedHashes {
+        explicit PrecomputedHashes() = default;
+    };
+    friend std::vector<std::shared_ptr<const CTransaction>> MakeTransactionRefs(std::vector<CMutableTransaction>&& txs);
+
 public:
     /** Convert a CMutableTransaction into a CTransaction. */
     explicit CTransaction(const CMutableTransaction& tx);
     explicit CTransaction(CMutableTransaction&& tx);
+    /** Convert a CMutableTransaction into a CTransaction whose hashes were computed by MakeTransactionRefs. */
+    CTransaction(PrecomputedHashes, CMutableTransaction&& tx, const Txid& txid, const Wtxid& wtxid);
 
     template <typename Stream>
     inline void Serialize(Stream& s) const {
@@ -403,6 +411,11 @@ struct CMutableTransaction
 typedef std::shared_ptr<const CTransaction> CTransactionRef;
 template <typename Tx> static inline CTransactionRef MakeTransactionRef(Tx&& txIn) { return std::make_shared<const CTransaction>(std::forward<Tx>(txIn)); }
 
+/** Convert many transactions at once, e.g. all transactions of a block.
+ *  Their txids and wtxids are computed together with SHA256DMulti, which can
+ *  hash several transactions in parallel on CPUs with multi-lane SHA256. */
+std::vector<CTransactionRef> MakeTransactionRefs(std::vector<CMutableTransaction>&& txs);
+
 namespace std {
 /** Disable default std::hash for CTransactionRef to prevent accidentally
  *  comparing by pointer. Use CTransactionRefHash or provide a custom
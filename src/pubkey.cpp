@@ -241,6 +241,30 @@ bool XOnlyPubKey::VerifySchnorr(const uint256& msg, std::span<const unsigned cha
     return secp256k1_schnorrsig_verify(secp256k1_context_static, sigbytes.data(), msg.begin(), 32, &pubkey);
 }
 
+void BatchSchnorrVerifier::Add(const XOnlyPubKey& pubkey, const uint256& msg, std::span<const unsigned char> sigbytes)
+{
+    assert(sigbytes.size() == 64);
+    Entry& entry{m_entries.emplace_back(pubkey, msg)};
+    std::copy(sigbytes.begin(), sigbytes.end(), entry.sig.begin());
+}
+
+bool BatchSchnorrVerifier::Verify()
+{
+    // Group signatures by key, so that keys spent from several times are parsed once.
+    std::sort(m_entries.begin(), m_entries.end(), [](const Entry& a, const Entry& b) { return a.pubkey < b.pubkey; });
+    bool ret{true};
+    secp256k1_xonly_pubkey pubkey;
+    for (size_t i{0}; i < m_entries.size() && ret; ++i) {
+        const Entry& entry{m_entries[i]};
+        if (i == 0 || !(entry.pubkey == m_entries[i - 1].pubkey)) {
+            if (!secp256k1_xonly_pubkey_parse(secp256k1_context_static, &pubkey, entry.pubkey.data())) ret = false;
+        }
+        ret = ret && secp256k1_schnorrsig_verify(secp256k1_context_static, entry.sig.data(), entry.msg.begin(), 32, &pubkey);
+    }
+    m_entries.clear();
+    return ret;
+}
+
 static const HashWriter HASHER_TAPTWEAK{TaggedHash("TapTweak")};
 
 uint256 XOnlyPubKey::ComputeTapTweakHash(const uint256* merkle_root) const
@@ -12,6 +12,7 @@
 #include <span.h>
 #include <uint256.h>
 
+#include <array>
 #include <cstring>
 #include <optional>
 #include <vector>
@@ -302,6 +303,32 @@ public:
     SERIALIZE_METHODS(XOnlyPubKey, obj) { READWRITE(obj.m_keydata); }
 };
 
+/** Collects BIP340 signatures so they can be verified together.
+ *
+ * Used where every signature must be valid for the overall check to
+ * succeed, so that verification can be deferred until all of them are known.
+ * Each distinct public key is parsed once per batch.
+ */
+class BatchSchnorrVerifier
+{
+private:
+    struct Entry {
+        XOnlyPubKey pubkey;
+        uint256 msg;
+        std::array<unsigned char, 64> sig;
+    };
+    std::vector<Entry> m_entries;
+
+public:
+    /** Add a signature to the batch. sigbytes must be exactly 64 bytes. */
+    void Add(const XOnlyPubKey& pubkey, const uint256& msg, std::span<const unsigned char> sigbytes);
+
+    /** Verify all signatures added since the last call. Returns false if any is invalid. */
+    [[nodiscard]] bool Verify();
+
+    size_t size() const { return m_entries.size(); }
+};
+
 /** An ElligatorSwift-encoded public key. */
 struct EllSwiftPubKey
 {
@@ -425,6 +425,34 @@ static bool rest_block(const std::any& context,
         pos = pblockindex->GetBlockPos();
     }
 
+    if (rf == RESTResponseFormat::BINARY) {
+        // Reply from the mapped block file, without reading the block into a buffer first.
+        if (const auto block_view{chainman.m_blockman.MapRawBlock(pos, block_part)}) {
+            req->WriteHeader("Content-Type", "application/octet-stream");
+            if (block_view->IsObfuscated()) {
+                std::vector<std::byte> block_data(block_view->size());
+                block_view->CopyTo(block_data);
+                req->WriteReply(HTTP_OK, block_data);
+            } else {
+                req->WriteReply(HTTP_OK, block_view->Stored());
+            }
+            return true;
+        }
+    }
+
+    if (rf == RESTResponseFormat::JSON && tx_verbosity) {
+        // Go through the recent block cache instead of deserializing the raw block again.
+        CBlock block{};
+        if (!chainman.m_blockman.ReadBlock(block, *pblockindex)) {
+            return RESTERR(req, HTTP_INTERNAL_SERVER_ERROR, "I/O error reading " + hashStr);
+        }
+        UniValue objBlock = blockToJSON(chainman.m_blockman, block, *tip, *pblockindex, *tx_verbosity, chainman.GetConsensus().powLimit);
+        std::string strJSON = objBlock.write() + "\n";
+        req->WriteHeader("Content-Type", "application/json");
+        req->WriteReply(HTTP_OK, strJSON);
+        return true;
+    }
+
     const auto block_data{chainman.m_blockman.ReadRawBlock(pos, block_part)};
     if (!block_data) {
         switch (block_data.error()) {
@@ -451,15 +479,7 @@ static bool rest_block(const std::any& context,
     }
 
     case RESTResponseFormat::JSON: {
-        if (tx_verbosity) {
-            CBlock block{};
-            SpanReader{*block_data} >> TX_WITH_WITNESS(block);
-            UniValue objBlock = blockToJSON(chainman.m_blockman, block, *tip, *pblockindex, *tx_verbosity, chainman.GetConsensus().powLimit);
-            std::string strJSON = objBlock.write() + "\n";
-            req->WriteHeader("Content-Type", "application/json");
-            req->WriteReply(HTTP_OK, strJSON);
-            return true;
-        }
+        // JSON with tx_verbosity was handled above.
         return RESTERR(req, HTTP_BAD_REQUEST, "JSON output is not supported for this request type");
     }
 
@@ -1002,27 +1022,43 @@ static bool rest_getutxos(const std::any& context, HTTPRequest* req, const std::
     decltype(chainman.ActiveHeight()) active_height;
     uint256 active_hash;
     {
-        auto process_utxos = [&vOutPoints, &outs, &hits, &active_height, &active_hash, &chainman](const CCoinsView& view, const CTxMemPool* mempool) EXCLUSIVE_LOCKS_REQUIRED(chainman.GetMutex()) {
-            for (const COutPoint& vOutPoint : vOutPoints) {
-                auto coin = !mempool || !mempool->isSpent(vOutPoint) ? view.GetCoin(vOutPoint) : std::nullopt;
-                hits.push_back(coin.has_value());
-                if (coin) outs.emplace_back(std::move(*coin));
-            }
-            active_height = chainman.ActiveHeight();
-            active_hash = chainman.ActiveTip()->GetBlockHash();
-        };
-
+        const CTxMemPool* mempool{nullptr};
         if (fCheckMemPool) {
-            const CTxMemPool* mempool = GetMemPool(context, req);
+            mempool = GetMemPool(context, req);
             if (!mempool) return false;
-            // use db+mempool as cache backend in case user likes to query mempool
-            LOCK2(cs_main, mempool->cs);
-            CCoinsViewCache& viewChain = chainman.ActiveChainstate().CoinsTip();
-            CCoinsViewMemPool viewMempool(&viewChain, *mempool);
-            process_utxos(viewMempool, mempool);
-        } else {
+        }
+        CCoinsViewCache* coins_tip = WITH_LOCK(cs_main, return &chainman.ActiveChainstate().CoinsTip());
+
+        // Look the coins up without cs_main, retrying if the tip changed in
+        // the meantime, so that all of them match the reported block.
+        uint256 best_block;
+        do {
+            hits.clear();
+            outs.clear();
+            best_block = coins_tip->GetBestBlock();
+            auto process_utxos = [&](const CCoinsView& view) {
+                for (const COutPoint& vOutPoint : vOutPoints) {
+                    auto coin = !mempool || !mempool->isSpent(vOutPoint) ? view.PeekCoin(vOutPoint) : std::nullopt;
+                    hits.push_back(coin.has_value());
+                    if (coin) outs.emplace_back(std::move(*coin));
+                }
+            };
+            if (mempool) {
+                // use db+mempool as cache backend in case user likes to query mempool
+                LOCK(mempool->cs);
+                CCoinsViewMemPool viewMempool(coins_tip, *mempool);
+                process_utxos(viewMempool);
+            } else {
+                process_utxos(*coins_tip);
+            }
+        } while (coins_tip->GetBestBlock() != best_block);
+
+        {
             LOCK(cs_main);
-            process_utxos(chainman.ActiveChainstate().CoinsTip(), nullptr);
+            const CBlockIndex* pindex{chainman.m_blockman.LookupBlockIndex(best_block)};
+            CHECK_NONFATAL(pindex);
+            active_height = pindex->nHeight;
+            active_hash = pindex->GetBlockHash();
         }
 
         for (size_t i = 0; i < hits.size(); ++i) {
@@ -90,7 +90,8 @@ UniValue WriteUTXOSnapshot(
     AutoFile&& afile,
     const fs::path& path,
     const fs::path& temppath,
-    const std::function<void()>& interruption_point = {});
+    const std::function<void()>& interruption_point = {},
+    bool chunked = false);
 
 UniValue CreateRolledBackUTXOSnapshot(
     NodeContext& node,
@@ -99,7 +100,8 @@ UniValue CreateRolledBackUTXOSnapshot(
     AutoFile&& afile,
     const fs::path& path,
     const fs::path& tmppath,
-    bool in_memory);
+    bool in_memory,
+    bool chunked);
 
 /* Calculate the difficulty for a given block index.
  */
@@ -866,14 +868,12 @@ static RPCMethod getblock()
         }
     }
 
-    const std::vector<std::byte> block_data{GetRawBlockChecked(chainman.m_blockman, *pblockindex)};
-
     if (verbosity <= 0) {
-        return HexStr(block_data);
+        return HexStr(GetRawBlockChecked(chainman.m_blockman, *pblockindex));
     }
 
-    CBlock block{};
-    SpanReader{block_data} >> TX_WITH_WITNESS(block);
+    // Go through the recent block cache, which is shared with getblockstats, REST and indexes.
+    const CBlock block{GetBlockChecked(chainman.m_blockman, *pblockindex)};
 
     TxVerbosity tx_verbosity;
     if (verbosity == 1) {
@@ -996,7 +996,8 @@ static std::optional<kernel::CCoinsStats> GetUTXOStats(const CCoinsViewDB& view,
                                                        kernel::CoinStatsHashType hash_type,
                                                        const std::function<void()>& interruption_point = {},
                                                        const CBlockIndex* pindex = nullptr,
-                                                       bool index_requested = true)
+                                                       bool index_requested = true,
+                                                       ThreadPool* thread_pool = nullptr)
 {
     // Use CoinStatsIndex if it is requested and available and a hash_type of Muhash or None was requested
     if ((hash_type == kernel::CoinStatsHashType::MUHASH || hash_type == kernel::CoinStatsHashType::NONE) && g_coin_stats_index && index_requested) {
@@ -1014,7 +1015,7 @@ static std::optional<kernel::CCoinsStats> GetUTXOStats(const CCoinsViewDB& view,
     // best block.
     CHECK_NONFATAL(!pindex || pindex->GetBlockHash() == view.GetBestBlock());
 
-    return kernel::ComputeUTXOStats(hash_type, view, blockman, interruption_point);
+    return kernel::ComputeUTXOStats(hash_type, view, blockman, interruption_point, thread_pool);
 }
 
 static RPCMethod gettxoutsetinfo()
@@ -1114,7 +1115,7 @@ static RPCMethod gettxoutsetinfo()
         }
     }
 
-    const std::optional<CCoinsStats> maybe_stats = GetUTXOStats(coins_view, blockman, hash_type, node.rpc_interruption_point, pindex, index_requested);
+    const std::optional<CCoinsStats> maybe_stats = GetUTXOStats(coins_view, blockman, hash_type, node.rpc_interruption_point, pindex, index_requested, chainman.GetThreadPool().get());
     if (maybe_stats.has_value()) {
         const CCoinsStats& stats = maybe_stats.value();
         ret.pushKV("height", stats.nHeight);
@@ -1136,7 +1137,7 @@ static RPCMethod gettxoutsetinfo()
             CCoinsStats prev_stats{};
             if (stats.nHeight > 0) {
                 const CBlockIndex& block_index = *CHECK_NONFATAL(WITH_LOCK(::cs_main, return blockman.LookupBlockIndex(stats.hashBlock)));
-                const std::optional<CCoinsStats> maybe_prev_stats = GetUTXOStats(coins_view, blockman, hash_type, node.rpc_interruption_point, block_index.pprev, index_requested);
+                const std::optional<CCoinsStats> maybe_prev_stats = GetUTXOStats(coins_view, blockman, hash_type, node.rpc_interruption_point, block_index.pprev, index_requested, chainman.GetThreadPool().get());
                 if (!maybe_prev_stats) {
                     throw JSONRPCError(RPC_INTERNAL_ERROR, "Unable to read UTXO set");
                 }
@@ -1222,7 +1223,6 @@ static RPCMethod gettxout()
 {
     NodeContext& node = EnsureAnyNodeContext(request.context);
     ChainstateManager& chainman = EnsureChainman(node);
-    LOCK(cs_main);
 
     UniValue ret(UniValue::VOBJ);
 
@@ -1233,20 +1233,26 @@ static RPCMethod gettxout()
         fMempool = request.params[2].get_bool();
 
     Chainstate& active_chainstate = chainman.ActiveChainstate();
-    CCoinsViewCache* coins_view = &active_chainstate.CoinsTip();
+    CCoinsViewCache* coins_view = WITH_LOCK(cs_main, return &active_chainstate.CoinsTip());
 
+    // Look the coin up without cs_main, retrying if a block was connected or
+    // disconnected in the meantime, so that it matches the best block.
     std::optional<Coin> coin;
-    if (fMempool) {
-        const CTxMemPool& mempool = EnsureMemPool(node);
-        LOCK(mempool.cs);
-        CCoinsViewMemPool view(coins_view, mempool);
-        if (!mempool.isSpent(out)) coin = view.GetCoin(out);
-    } else {
-        coin = coins_view->GetCoin(out);
-    }
+    uint256 best_block;
+    do {
+        best_block = coins_view->GetBestBlock();
+        if (fMempool) {
+            const CTxMemPool& mempool = EnsureMemPool(node);
+            LOCK(mempool.cs);
+            CCoinsViewMemPool view(coins_view, mempool);
+            coin = mempool.isSpent(out) ? std::nullopt : view.PeekCoin(out);
+        } else {
+            coin = coins_view->PeekCoin(out);
+        }
+    } while (coins_view->GetBestBlock() != best_block);
     if (!coin) return UniValue::VNULL;
 
-    const CBlockIndex* pindex = active_chainstate.m_blockman.LookupBlockIndex(coins_view->GetBestBlock());
+    const CBlockIndex* pindex = WITH_LOCK(cs_main, return active_chainstate.m_blockman.LookupBlockIndex(best_block));
     ret.pushKV("bestblock", pindex->GetBlockHash().GetHex());
     if (coin->nHeight == MEMPOOL_HEIGHT) {
         ret.pushKV("confirmations", 0);
@@ -3080,6 +3086,7 @@ static RPCMethod dumptxoutset()
                         "Height or hash of the block to roll back to before creating the snapshot. Note: The further this number is from the tip, the longer this process will take. Consider setting a higher -rpcclienttimeout value in this case.",
                     RPCArgOptions{.skip_type_check = true, .type_str = {"", "string or numeric"}}},
                     {"in_memory", RPCArg::Type::BOOL, RPCArg::Default{false}, "If true, the temporary UTXO-set database used during rollback is kept entirely in memory. This can significantly speed up the process but requires sufficient free RAM (over 10 GB on mainnet)."},
+                    {"chunked", RPCArg::Type::BOOL, RPCArg::Default{false}, "If true, write the snapshot in the chunked format, in which each chunk of coins is hashed separately so that loading can check and deserialize chunks in parallel. Chunked snapshots cannot be loaded by nodes that only support the unchunked format."},
                 },
             },
         },
@@ -3098,7 +3105,8 @@ static RPCMethod dumptxoutset()
             HelpExampleCli("-rpcclienttimeout=0 dumptxoutset", "utxo.dat latest") +
             HelpExampleCli("-rpcclienttimeout=0 dumptxoutset", "utxo.dat rollback") +
             HelpExampleCli("-rpcclienttimeout=0 -named dumptxoutset", R"(utxo.dat rollback=853456)") +
-            HelpExampleCli("-rpcclienttimeout=0 -named dumptxoutset", R"(utxo.dat rollback=853456 in_memory=true)")
+            HelpExampleCli("-rpcclienttimeout=0 -named dumptxoutset", R"(utxo.dat rollback=853456 in_memory=true)") +
+            HelpExampleCli("-rpcclienttimeout=0 -named dumptxoutset", R"(utxo.dat latest chunked=true)")
         },
         [](const RPCMethod& self, const JSONRPCRequest& request) -> UniValue
 {
@@ -3145,11 +3153,12 @@ static RPCMethod dumptxoutset()
             "Couldn't open file " + temppath.utf8string() + " for writing.");
     }
 
+    const bool chunked{options.exists("chunked") ? options["chunked"].get_bool() : false};
     UniValue result;
     Chainstate& chainstate{node.chainman->ActiveChainstate()};
     if (target_index == tip) {
         // Dump the txoutset of the current tip
-        result = CreateUTXOSnapshot(node, chainstate, std::move(afile), path, temppath);
+        result = CreateUTXOSnapshot(node, chainstate, std::move(afile), path, temppath, chunked);
     } else {
         // Check pruning constraints before attempting rollback and prevent
         // pruning of the necessary blocks with a temporary prune lock
@@ -3171,7 +3180,8 @@ static RPCMethod dumptxoutset()
                                               std::move(afile),
                                               path,
                                               temppath,
-                                              in_memory);
+                                              in_memory,
+                                              chunked);
     }
 
     if (!fs::is_fifo(path_info)) {
@@ -3209,7 +3219,8 @@ UniValue CreateRolledBackUTXOSnapshot(
     AutoFile&& afile,
     const fs::path& path,
     const fs::path& tmppath,
-    const bool in_memory)
+    const bool in_memory,
+    const bool chunked)
 {
     // Create a temporary leveldb to store the UTXO set that is being rolled back
     std::string temp_db_name{strprintf("temp_utxo_%d", target->nHeight)};
@@ -3250,6 +3261,8 @@ UniValue CreateRolledBackUTXOSnapshot(
             cursor = chainstate.CoinsDB().Cursor();
         }
         temp_cache.SetBestBlock(tip->GetBlockHash());
+        // The cursor iterates in key order, so the copy can be bulk loaded.
+        temp_db->StartBulkLoad();
 
         size_t coins_count = 0;
         while (cursor->Valid()) {
@@ -3274,6 +3287,9 @@ UniValue CreateRolledBackUTXOSnapshot(
             cursor->Next();
         }
 
+        temp_cache.Flush();
+        temp_db->FinishBulkLoad();
+        // Record the best block now that all coins are written.
         temp_cache.Flush();
         LogInfo("UTXO set copy complete: %u coins total", coins_count);
     }
@@ -3337,7 +3353,8 @@ UniValue CreateRolledBackUTXOSnapshot(
                              std::move(afile),
                              path,
                              tmppath,
-                             node.rpc_interruption_point);
+                             node.rpc_interruption_point,
+                             chunked);
 }
 
 std::tuple<std::unique_ptr<CCoinsViewCursor>, CCoinsStats, const CBlockIndex*>
@@ -3386,13 +3403,14 @@ UniValue WriteUTXOSnapshot(
     AutoFile&& afile,
     const fs::path& path,
     const fs::path& temppath,
-    const std::function<void()>& interruption_point)
+    const std::function<void()>& interruption_point,
+    const bool chunked)
 {
     LOG_TIME_SECONDS(strprintf("writing UTXO snapshot at height %s (%s) to file %s (via %s)",
         tip->nHeight, tip->GetBlockHash().ToString(),
         fs::PathToString(path), fs::PathToString(temppath)));
 
-    SnapshotMetadata metadata{chainstate.m_chainman.GetParams().MessageStart(), tip->GetBlockHash(), maybe_stats->coins_count};
+    SnapshotMetadata metadata{chainstate.m_chainman.GetParams().MessageStart(), tip->GetBlockHash(), maybe_stats->coins_count, chunked};
 
     afile << metadata;
 
@@ -3410,16 +3428,35 @@ UniValue WriteUTXOSnapshot(
     // (key.hash) and when we have them all (key.hash != last_hash) we write
     // them to file using the below lambda function.
     // See also https://github.com/bitcoin/bitcoin/issues/25675
-    auto write_coins_to_file = [&](AutoFile& afile, const Txid& last_hash, const std::vector<std::pair<uint32_t, Coin>>& coins, size_t& written_coins_count) {
-        afile << last_hash;
-        WriteCompactSize(afile, coins.size());
+    auto write_coins = [&](auto& stream, const Txid& last_hash, const std::vector<std::pair<uint32_t, Coin>>& coins, size_t& written_coins_count) {
+        stream << last_hash;
+        WriteCompactSize(stream, coins.size());
         for (const auto& [n, coin] : coins) {
-            WriteCompactSize(afile, n);
-            afile << coin;
+            WriteCompactSize(stream, n);
+            stream << coin;
             ++written_coins_count;
         }
     };
 
+    // In the chunked format the coins are collected in a chunk first, which is
+    // written to file together with its hash once it is large enough.
+    DataStream chunk_data;
+    size_t chunk_start_coins_count{0};
+    auto write_chunk_to_file = [&] {
+        node::SnapshotChunk chunk;
+        chunk.coins_count = written_coins_count - chunk_start_coins_count;
+        chunk.data.assign(chunk_data.begin(), chunk_data.end());
+        chunk.hash = Hash(chunk.data);
+        afile << chunk;
+        chunk_data.clear();
+        chunk_start_coins_count = written_coins_count;
+    };
+    auto write_coins_to_file = [&](AutoFile& afile, const Txid& last_hash, const std::vector<std::pair<uint32_t, Coin>>& coins, size_t& written_coins_count) {
+        if (!chunked) return write_coins(afile, last_hash, coins, written_coins_count);
+        write_coins(chunk_data, last_hash, coins, written_coins_count);
+        if (chunk_data.size() >= node::SNAPSHOT_CHUNK_TARGET_SIZE) write_chunk_to_file();
+    };
+
     pcursor->GetKey(key);
     last_hash = key.hash;
     while (pcursor->Valid()) {
@@ -3439,6 +3476,9 @@ UniValue WriteUTXOSnapshot(
     if (!coins.empty()) {
         write_coins_to_file(afile, last_hash, coins, written_coins_count);
     }
+    if (!chunk_data.empty()) {
+        write_chunk_to_file();
+    }
 
     CHECK_NONFATAL(written_coins_count == maybe_stats->coins_count);
 
@@ -3462,7 +3502,8 @@ UniValue CreateUTXOSnapshot(
     Chainstate& chainstate,
     AutoFile&& afile,
     const fs::path& path,
-    const fs::path& tmppath)
+    const fs::path& tmppath,
+    const bool chunked)
 {
     auto [cursor, stats, tip]{WITH_LOCK(::cs_main, return PrepareUTXOSnapshot(chainstate, node.rpc_interruption_point))};
     return WriteUTXOSnapshot(chainstate,
@@ -3472,7 +3513,8 @@ UniValue CreateUTXOSnapshot(
                              std::move(afile),
                              path,
                              tmppath,
-                             node.rpc_interruption_point);
+                             node.rpc_interruption_point,
+                             chunked);
 }
 
 static RPCMethod loadtxoutset()
@@ -3628,6 +3670,125 @@ return RPCMethod{
     };
 }
 
+static RPCMethod getblockcacheinfo()
+{
+return RPCMethod{
+        "getblockcacheinfo",
+        "Return information about the cache of recently read blocks and undo data.\n",
+        {},
+        RPCResult{
+            RPCResult::Type::OBJ, "", "", {
+                {RPCResult::Type::NUM, "blocks", "the number of cached blocks"},
+                {RPCResult::Type::NUM, "undos", "the number of cached block undo entries"},
+                {RPCResult::Type::NUM, "usage", "the estimated memory usage of the cache in bytes"},
+                {RPCResult::Type::NUM, "max_usage", "the maximum memory usage of the cache in bytes (set by -blockcache)"},
+                {RPCResult::Type::NUM, "block_hits", "the number of block reads served from the cache"},
+                {RPCResult::Type::NUM, "block_misses", "the number of block reads that had to go to disk"},
+                {RPCResult::Type::NUM, "undo_hits", "the number of block undo reads served from the cache"},
+                {RPCResult::Type::NUM, "undo_misses", "the number of block undo reads that had to go to disk"},
+            }
+        },
+        RPCExamples{
+            HelpExampleCli("getblockcacheinfo", "")
+    + HelpExampleRpc("getblockcacheinfo", "")
+        },
+        [](const RPCMethod& self, const JSONRPCRequest& request) -> UniValue
+{
+    ChainstateManager& chainman = EnsureAnyChainman(request.context);
+    const auto stats{chainman.m_blockman.GetBlockCacheStats()};
+
+    UniValue obj(UniValue::VOBJ);
+    obj.pushKV("blocks", stats.blocks);
+    obj.pushKV("undos", stats.undos);
+    obj.pushKV("usage", stats.usage);
+    obj.pushKV("max_usage", stats.max_usage);
+    obj.pushKV("block_hits", stats.block_hits);
+    obj.pushKV("block_misses", stats.block_misses);
+    obj.pushKV("undo_hits", stats.undo_hits);
+    obj.pushKV("undo_misses", stats.undo_misses);
+    return obj;
+}
+    };
+}
+
+static RPCMethod getcoinscacheinfo()
+{
+return RPCMethod{
+        "getcoinscacheinfo",
+        "Return lookup statistics of the active chainstate's UTXO cache and database.\n"
+        "Counters are cumulative; run with -debug=bench to log them for each connected block.\n",
+        {},
+        RPCResult{
+            RPCResult::Type::OBJ, "", "", {
+                {RPCResult::Type::NUM, "entries", "the number of coins in the cache"},
+                {RPCResult::Type::NUM, "usage", "the estimated memory usage of the cache in bytes"},
+                {RPCResult::Type::NUM, "hits", "the number of lookups served from the cache"},
+                {RPCResult::Type::NUM, "misses", "the number of lookups that had to go to the database"},
+                {RPCResult::Type::OBJ, "prefetch", "block input prefetching while connecting blocks", {
+                    {RPCResult::Type::NUM, "lookups", "the number of coins looked up while connecting blocks"},
+                    {RPCResult::Type::NUM, "hits", "the number of inputs that had been prefetched"},
+                    {RPCResult::Type::NUM, "misses", "the number of inputs that were read without prefetching"},
+                }},
+                {RPCResult::Type::OBJ, "db", "accesses to the chainstate database since it was last opened", {
+                    {RPCResult::Type::NUM, "reads", "the number of point lookups"},
+                    {RPCResult::Type::NUM, "reads_found", "the number of lookups that found their key"},
+                    {RPCResult::Type::NUM, "read_bytes", "the size of the values read in bytes"},
+                    {RPCResult::Type::NUM, "read_time", "the time spent in lookups in microseconds"},
+                    {RPCResult::Type::ARR_FIXED, "read_latency", "a histogram of lookup latencies: element i counts lookups that took less than 2^i microseconds, the last element also counts all slower lookups", {
+                        {RPCResult::Type::NUM, "", "the number of lookups"},
+                    }},
+                    {RPCResult::Type::NUM, "batches_written", "the number of write batches"},
+                    {RPCResult::Type::NUM, "write_bytes", "the approximate size of the batches written in bytes"},
+                    {RPCResult::Type::NUM, "write_time", "the time spent writing batches in microseconds, including stalls while the database compacts"},
+                    {RPCResult::Type::STR, "leveldb_stats", /*optional=*/true, "the LevelDB per-level compaction statistics"},
+                }},
+            }
+        },
+        RPCExamples{
+            HelpExampleCli("getcoinscacheinfo", "")
+    + HelpExampleRpc("getcoinscacheinfo", "")
+        },
+        [](const RPCMethod& self, const JSONRPCRequest& request) -> UniValue
+{
+    ChainstateManager& chainman = EnsureAnyChainman(request.context);
+    LOCK(cs_main);
+    Chainstate& chainstate{chainman.ActiveChainstate()};
+    const CCoinsViewCache& tip{chainstate.CoinsTip()};
+    const auto tip_stats{tip.GetStats()};
+    const auto prefetch_stats{chainstate.ConnectBlockView().GetStats()};
+    const auto db_stats{chainstate.CoinsDB().GetDBStats()};
+
+    UniValue obj(UniValue::VOBJ);
+    obj.pushKV("entries", tip.GetCacheSize());
+    obj.pushKV("usage", tip.DynamicMemoryUsage());
+    obj.pushKV("hits", tip_stats.hits);
+    obj.pushKV("misses", tip_stats.misses);
+
+    UniValue prefetch(UniValue::VOBJ);
+    prefetch.pushKV("lookups", prefetch_stats.hits + prefetch_stats.misses);
+    prefetch.pushKV("hits", prefetch_stats.prefetch_hits);
+    prefetch.pushKV("misses", prefetch_stats.prefetch_misses);
+    obj.pushKV("prefetch", std::move(prefetch));
+
+    UniValue db(UniValue::VOBJ);
+    db.pushKV("reads", db_stats.reads);
+    db.pushKV("reads_found", db_stats.reads_found);
+    db.pushKV("read_bytes", db_stats.read_bytes);
+    db.pushKV("read_time", count_microseconds(db_stats.read_time));
+    UniValue read_latency(UniValue::VARR);
+    for (const uint64_t count : db_stats.read_latency) read_latency.push_back(count);
+    db.pushKV("read_latency", std::move(read_latency));
+    db.pushKV("batches_written", db_stats.batches_written);
+    db.pushKV("write_bytes", db_stats.write_bytes);
+    db.pushKV("write_time", count_microseconds(db_stats.write_time));
+    if (const auto leveldb_stats{chainstate.CoinsDB().GetDBProperty("leveldb.stats")}) {
+        db.pushKV("leveldb_stats", *leveldb_stats);
+    }
+    obj.pushKV("db", std::move(db));
+    return obj;
+}
+    };
+}
 
 void RegisterBlockchainRPCCommands(CRPCTable& t)
 {
@@ -3656,6 +3817,8 @@ void RegisterBlockchainRPCCommands(CRPCTable& t)
         {"blockchain", &dumptxoutset},
         {"blockchain", &loadtxoutset},
         {"blockchain", &getchainstates},
+        {"blockchain", &getblockcacheinfo},
+        {"blockchain", &getcoinscacheinfo},
         {"hidden", &invalidateblock},
         {"hidden", &reconsiderblock},
         {"blockchain", &waitfornewblock},
@@ -55,7 +55,8 @@ UniValue CreateUTXOSnapshot(
     Chainstate& chainstate,
     AutoFile&& afile,
     const fs::path& path,
-    const fs::path& tmppath);
+    const fs::path& tmppath,
+    bool chunked = false);
 
 //! Return height of highest block that has been pruned, or std::nullopt if no blocks have been pruned
 std::optional<int> GetPruneHeight(const node::BlockManager& blockman, const CChain& chain) EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
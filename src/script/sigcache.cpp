@@ -78,6 +78,12 @@ bool CachingTransactionSignatureChecker::VerifySchnorrSignature(std::span<const
     uint256 entry;
     m_signature_cache.ComputeEntrySchnorr(entry, sighash, sig, pubkey);
     if (m_signature_cache.Get(entry, !store)) return true;
+    // An invalid BIP340 signature always fails the script, so the outcome of a deferred check
+    // can only turn success into failure. Results that are cached must have been verified.
+    if (m_batch && !store) {
+        m_batch->Add(pubkey, sighash, sig);
+        return true;
+    }
     if (!TransactionSignatureChecker::VerifySchnorrSignature(sig, pubkey, sighash)) return false;
     if (store) m_signature_cache.Set(entry);
     return true;
@@ -21,6 +21,7 @@
 #include <span>
 #include <vector>
 
+class BatchSchnorrVerifier;
 class CPubKey;
 class CTransaction;
 class XOnlyPubKey;
@@ -68,9 +69,11 @@ class CachingTransactionSignatureChecker : public TransactionSignatureChecker
 private:
     bool store;
     SignatureCache& m_signature_cache;
+    //! If set, and results are not stored, Schnorr signatures missing from the cache are deferred to it.
+    BatchSchnorrVerifier* m_batch;
 
 public:
-    CachingTransactionSignatureChecker(const CTransaction* txToIn, unsigned int nInIn, const CAmount& amountIn, bool storeIn, SignatureCache& signature_cache, PrecomputedTransactionData& txdataIn) : TransactionSignatureChecker(txToIn, nInIn, amountIn, txdataIn, MissingDataBehavior::ASSERT_FAIL), store(storeIn), m_signature_cache(signature_cache)  {}
+    CachingTransactionSignatureChecker(const CTransaction* txToIn, unsigned int nInIn, const CAmount& amountIn, bool storeIn, SignatureCache& signature_cache, PrecomputedTransactionData& txdataIn, BatchSchnorrVerifier* batch = nullptr) : TransactionSignatureChecker(txToIn, nInIn, amountIn, txdataIn, MissingDataBehavior::ASSERT_FAIL), store(storeIn), m_signature_cache(signature_cache), m_batch(batch) {}
 
     bool VerifyECDSASignature(const std::vector<unsigned char>& vchSig, const CPubKey& vchPubKey, const uint256& sighash) const override;
     bool VerifySchnorrSignature(std::span<const unsigned char> sig, const XOnlyPubKey& pubkey, const uint256& sighash) const override;
@@ -4,14 +4,21 @@
 
 #include <index/coinstatsindex.h>
 #include <interfaces/chain.h>
+#include <primitives/block.h>
 #include <script/script.h>
 #include <test/util/setup_common.h>
+#include <undo.h>
 #include <util/byte_units.h>
 #include <util/check.h>
 #include <validation.h>
 
 #include <boost/test/unit_test.hpp>
 
+#include <atomic>
+#include <functional>
+#include <numeric>
+#include <vector>
+
 // Tests of generic BaseIndex functionality that is independent of which
 // concrete index is being used. CoinStatsIndex is used here merely as a
 // convenient instantiation of BaseIndex.
@@ -59,4 +66,50 @@ BOOST_FIXTURE_TEST_CASE(baseindex_no_commit_ahead_of_flush, TestChain100Setup)
     sync_index(false, 101, 100);
 }
 
+//! Index that prepares blocks through CustomPrepare and records the order they are appended in.
+class PreparingIndex : public BaseIndex
+{
+private:
+    std::unique_ptr<BaseIndex::DB> m_db;
+
+public:
+    std::atomic<int> m_num_prepared{0};
+    std::vector<int> m_appended;
+
+    explicit PreparingIndex(std::unique_ptr<interfaces::Chain> chain)
+        : BaseIndex(std::move(chain), "preparing index", "prepidx"),
+          m_db{std::make_unique<BaseIndex::DB>(gArgs.GetDataDirNet() / "preparing_index", /*n_cache_size=*/0, /*f_memory=*/true)} {}
+
+    bool AllowPrune() const override { return false; }
+    BaseIndex::DB& GetDB() const override { return *m_db; }
+    interfaces::Chain::NotifyOptions CustomOptions() override { return {.connect_undo_data = true}; }
+
+    std::function<bool()> CustomPrepare(const interfaces::BlockInfo& block) override
+    {
+        ++m_num_prepared;
+        const bool has_data{block.data && block.undo_data &&
+                            (block.height == 0 || block.undo_data->vtxundo.size() + 1 == block.data->vtx.size())};
+        return [this, height = block.height, has_data] {
+            m_appended.push_back(height);
+            return has_data;
+        };
+    }
+};
+
+// Test that blocks prepared on the validation thread pool during sync are
+// appended once each, in chain order, with their block and undo data.
+BOOST_FIXTURE_TEST_CASE(baseindex_prepare_in_order, TestChain100Setup)
+{
+    PreparingIndex index{interfaces::MakeChain(m_node)};
+    BOOST_REQUIRE(index.Init());
+    index.Sync();
+    BOOST_CHECK_EQUAL(index.GetSummary().best_block_height, 100);
+
+    std::vector<int> expected(101);
+    std::iota(expected.begin(), expected.end(), 0);
+    BOOST_CHECK_EQUAL_COLLECTIONS(index.m_appended.begin(), index.m_appended.end(), expected.begin(), expected.end());
+    BOOST_CHECK_EQUAL(index.m_num_prepared, 101);
+    index.Stop();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -5,11 +5,13 @@
 #include <chain.h>
 #include <chainparams.h>
 #include <clientversion.h>
+#include <core_memusage.h>
 #include <node/blockstorage.h>
 #include <node/context.h>
 #include <node/kernel_notifications.h>
 #include <script/solver.h>
 #include <primitives/block.h>
+#include <undo.h>
 #include <util/chaintype.h>
 #include <validation.h>
 
@@ -216,6 +218,102 @@ BOOST_FIXTURE_TEST_CASE(blockmanager_block_data_part_error, TestChain100Setup)
     expect_part_error(std::numeric_limits<size_t>::max(), std::numeric_limits<size_t>::max());
 }
 
+#ifndef WIN32
+BOOST_FIXTURE_TEST_CASE(blockmanager_map_raw_block, TestChain100Setup)
+{
+    auto& blockman{m_node.chainman->m_blockman};
+
+    const auto expect_same_data{[&](const FlatFilePos& pos, std::optional<std::pair<size_t, size_t>> block_part) {
+        const auto block_data{blockman.ReadRawBlock(pos, block_part)};
+        const auto block_view{blockman.MapRawBlock(pos, block_part)};
+        BOOST_REQUIRE(block_data);
+        BOOST_REQUIRE(block_view);
+        BOOST_CHECK(block_view->IsObfuscated());
+        std::vector<std::byte> mapped_data(block_view->size());
+        block_view->CopyTo(mapped_data);
+        BOOST_CHECK(mapped_data == *block_data);
+    }};
+
+    std::vector<FlatFilePos> block_positions;
+    {
+        LOCK(::cs_main);
+        for (const CBlockIndex* index{m_node.chainman->ActiveTip()}; index; index = index->pprev) {
+            block_positions.push_back(index->GetBlockPos());
+        }
+    }
+    for (const auto& pos : block_positions) {
+        expect_same_data(pos, std::nullopt);
+    }
+
+    const FlatFilePos tip_block_pos{block_positions.front()};
+    const size_t tip_block_size{blockman.ReadRawBlock(tip_block_pos)->size()};
+    expect_same_data(tip_block_pos, std::pair{0, 20});
+    expect_same_data(tip_block_pos, std::pair{1, tip_block_size - 1});
+    expect_same_data(tip_block_pos, std::pair{tip_block_size - 1, 1});
+    expect_same_data(tip_block_pos, std::pair{13, 27});
+
+    for (const auto& [offset, size] : {std::pair<size_t, size_t>{0, 0}, {0, tip_block_size + 1}, {tip_block_size, 1}, {std::numeric_limits<size_t>::max(), 1}}) {
+        const auto res{blockman.MapRawBlock(tip_block_pos, std::pair{offset, size})};
+        BOOST_REQUIRE(!res);
+        BOOST_CHECK_EQUAL(res.error(), node::ReadRawError::BadPartRange);
+    }
+
+    // Blocks written after the block file was mapped can be mapped as well.
+    CreateAndProcessBlock({}, CScript{} << OP_TRUE);
+    expect_same_data(WITH_LOCK(::cs_main, return m_node.chainman->ActiveTip()->GetBlockPos()), std::nullopt);
+
+    ASSERT_DEBUG_LOG("while mapping raw block storage header");
+    BOOST_CHECK(!blockman.MapRawBlock(FlatFilePos{0, 0}));
+}
+#endif // WIN32
+
+BOOST_FIXTURE_TEST_CASE(blockmanager_recent_block_cache, TestChain100Setup)
+{
+    auto& blockman{m_node.chainman->m_blockman};
+    const CBlockIndex* tip{WITH_LOCK(::cs_main, return m_node.chainman->ActiveTip())};
+
+    const auto before{blockman.GetBlockCacheStats()};
+    CBlock block;
+    CBlockUndo blockundo;
+    for (int i{0}; i < 3; ++i) {
+        BOOST_REQUIRE(blockman.ReadBlock(block, *tip));
+        BOOST_CHECK_EQUAL(block.GetHash(), tip->GetBlockHash());
+        BOOST_REQUIRE(blockman.ReadBlockUndo(blockundo, *tip));
+        BOOST_CHECK_EQUAL(blockundo.vtxundo.size(), block.vtx.size() - 1);
+    }
+    const auto after{blockman.GetBlockCacheStats()};
+    BOOST_CHECK_EQUAL(after.block_misses, before.block_misses + 1);
+    BOOST_CHECK_EQUAL(after.block_hits, before.block_hits + 2);
+    BOOST_CHECK_EQUAL(after.undo_misses, before.undo_misses + 1);
+    BOOST_CHECK_EQUAL(after.undo_hits, before.undo_hits + 2);
+    BOOST_CHECK_LE(after.usage, after.max_usage);
+
+    // Least recently used entries are evicted first.
+    const auto block_usage{RecursiveDynamicUsage(block)};
+    node::RecentBlockCache cache{2 * block_usage};
+    const auto cached_block{std::make_shared<const CBlock>(block)};
+    cache.AddBlock(uint256::ONE, 0, cached_block);
+    cache.AddBlock(uint256::ZERO, 1, cached_block);
+    BOOST_CHECK(cache.GetBlock(uint256::ONE));
+    cache.AddBlock(tip->GetBlockHash(), 2, cached_block);
+    BOOST_CHECK(cache.GetBlock(uint256::ONE));
+    BOOST_CHECK(!cache.GetBlock(uint256::ZERO));
+    BOOST_CHECK(cache.GetBlock(tip->GetBlockHash()));
+    BOOST_CHECK_EQUAL(cache.GetStats().usage, 2 * block_usage);
+
+    // Entries from pruned files are dropped.
+    cache.EraseFiles({0});
+    BOOST_CHECK(!cache.GetBlock(uint256::ONE));
+    BOOST_CHECK(cache.GetBlock(tip->GetBlockHash()));
+    BOOST_CHECK_EQUAL(cache.GetStats().blocks, 1);
+
+    // A disabled cache stores nothing.
+    node::RecentBlockCache disabled{0};
+    disabled.AddBlock(uint256::ONE, 0, cached_block);
+    BOOST_CHECK(!disabled.GetBlock(uint256::ONE));
+    BOOST_CHECK_EQUAL(disabled.GetStats().blocks, 0);
+}
+
 BOOST_FIXTURE_TEST_CASE(blockmanager_readblock_hash_mismatch, TestingSetup)
 {
     CBlockIndex index;
@@ -64,6 +64,23 @@ struct FixedCheck
     std::optional<int> operator()() const { return m_result; }
 };
 
+/** A check that defers its failure, if any, to the batch. */
+struct BatchedCheck
+{
+    struct Batch {
+        bool m_valid{true};
+        bool Verify() { return m_valid; }
+    };
+    std::optional<int> m_result;
+    BatchedCheck(std::optional<int> result) : m_result(result){};
+    std::optional<int> operator()() const { return m_result; }
+    std::optional<int> operator()(Batch& batch) const
+    {
+        if (m_result) batch.m_valid = false;
+        return std::nullopt;
+    }
+};
+
 struct UniqueCheck {
     static Mutex m;
     static std::unordered_multiset<size_t> results GUARDED_BY(m);
@@ -148,6 +165,7 @@ std::atomic<size_t> MemoryCheck::fake_allocated_memory{0};
 typedef CCheckQueue<FakeCheckCheckCompletion> Correct_Queue;
 typedef CCheckQueue<FakeCheck> Standard_Queue;
 typedef CCheckQueue<FixedCheck> Fixed_Queue;
+typedef CCheckQueue<BatchedCheck> Batched_Queue;
 typedef CCheckQueue<UniqueCheck> Unique_Queue;
 typedef CCheckQueue<MemoryCheck> Memory_Queue;
 typedef CCheckQueue<FrozenCleanupCheck> FrozenCleanup_Queue;
@@ -239,6 +257,28 @@ BOOST_AUTO_TEST_CASE(test_CheckQueue_Catches_Failure)
         }
     }
 }
+/** Test that a failing batch is attributed to the check that caused it */
+BOOST_AUTO_TEST_CASE(test_CheckQueue_Batch_Failure)
+{
+    static_assert(BatchableCheck<BatchedCheck>);
+    static_assert(!BatchableCheck<FixedCheck>);
+    auto batched_queue = std::make_unique<Batched_Queue>(QUEUE_BATCH_SIZE, SCRIPT_CHECK_THREADS);
+    for (size_t i = 0; i < 1001; ++i) {
+        CCheckQueueControl<BatchedCheck> control(*batched_queue);
+        std::vector<BatchedCheck> vChecks;
+        for (size_t k = 0; k < i; ++k) {
+            vChecks.emplace_back(k + 1 == i ? std::make_optional<int>(17 * i) : std::nullopt);
+        }
+        control.Add(std::move(vChecks));
+        auto result = control.Complete();
+        if (i > 0) {
+            BOOST_REQUIRE(result.has_value() && *result == static_cast<int>(17 * i));
+        } else {
+            BOOST_REQUIRE(!result.has_value());
+        }
+    }
+}
+
 // Test that a block validation which fails does not interfere with
 // future blocks, ie, the bad state is cleared.
 BOOST_AUTO_TEST_CASE(test_CheckQueue_Recovers_From_Failure)
@@ -17,8 +17,11 @@
 #include <util/check.h>
 #include <util/strencodings.h>
 
+#include <algorithm>
+#include <atomic>
 #include <map>
 #include <string>
+#include <thread>
 #include <variant>
 #include <vector>
 
@@ -1085,6 +1088,147 @@ BOOST_FIXTURE_TEST_CASE(coins_db_leveldb_layout, FlushTest)
     BOOST_CHECK_EQUAL(base.GetBestBlock(), block_hash);
 }
 
+BOOST_FIXTURE_TEST_CASE(coins_db_bulk_load, FlushTest)
+{
+    auto files_at_level{[](CCoinsViewDB& base, int level) {
+        return *Assert(ToIntegral<int>(*Assert(base.GetDBProperty(strprintf("leveldb.num-files-at-level%d", level)))));
+    }};
+    std::vector<COutPoint> outpoints;
+    for (int i{0}; i < 20'000; ++i) outpoints.emplace_back(Txid::FromUint256(m_rng.rand256()), uint32_t(m_rng.randbits(2)));
+    std::sort(outpoints.begin(), outpoints.end());
+    const Coin coin{MakeCoin()};
+    const uint256 block_hash{m_rng.rand256()};
+
+    // A small cache makes LevelDB write several tables during the load.
+    CCoinsViewDB base{{.path = m_args.GetDataDirBase() / "coins_db_bulk_load", .cache_bytes = 1_MiB, .wipe_data = true}, {}};
+    CCoinsViewCache cache{&base};
+    cache.SetBestBlock(block_hash);
+
+    base.StartBulkLoad();
+    for (size_t i{0}; i < outpoints.size(); ++i) {
+        cache.EmplaceCoinInternalDANGER(COutPoint{outpoints[i]}, Coin{coin});
+        if (i % 5'000 == 4'999) cache.Flush();
+    }
+    cache.Flush();
+    // The best block is only recorded once the bulk load is finished.
+    BOOST_CHECK(base.GetBestBlock().IsNull());
+    BOOST_CHECK(base.GetHeadBlocks().empty());
+    base.FinishBulkLoad();
+    cache.Flush();
+    BOOST_CHECK_EQUAL(base.GetBestBlock(), block_hash);
+    BOOST_CHECK(base.GetHeadBlocks().empty());
+
+    // The coins were written in key order, so no table had to go to level 0.
+    BOOST_CHECK_EQUAL(files_at_level(base, 0), 0);
+    for (const auto& outpoint : outpoints) {
+        BOOST_CHECK(*Assert(base.GetCoin(outpoint)) == coin);
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(coins_db_background_flush, FlushTest)
+{
+    std::vector<COutPoint> outpoints;
+    for (int i{0}; i < 2'000; ++i) outpoints.emplace_back(Txid::FromUint256(m_rng.rand256()), uint32_t(i));
+    const Coin coin{MakeCoin()};
+
+    // A small batch size makes the background thread write several batches.
+    CCoinsViewDB base{{.path = m_args.GetDataDirBase() / "coins_db_background_flush", .cache_bytes = 1_MiB, .wipe_data = true},
+                      {.batch_write_bytes = 4096, .background_flush = true}};
+    CCoinsViewCache cache{&base};
+
+    auto check_base{[&](const uint256& block_hash, size_t num_spent) {
+        BOOST_CHECK_EQUAL(base.GetBestBlock(), block_hash);
+        BOOST_CHECK(base.GetHeadBlocks().empty());
+        const auto peeked{base.PeekCoins(outpoints)};
+        for (size_t i{0}; i < outpoints.size(); ++i) {
+            BOOST_CHECK_EQUAL(base.HaveCoin(outpoints[i]), i >= num_spent);
+            BOOST_CHECK_EQUAL(base.GetCoin(outpoints[i]).has_value(), i >= num_spent);
+            BOOST_CHECK_EQUAL(peeked[i].has_value(), i >= num_spent);
+        }
+    }};
+
+    const uint256 block1{m_rng.rand256()};
+    for (const auto& outpoint : outpoints) cache.AddCoin(outpoint, Coin{coin}, /*possible_overwrite=*/false);
+    cache.SetBestBlock(block1);
+    // Reads see the whole flush, whether or not it has been written yet.
+    cache.Flush();
+    check_base(block1, 0);
+    base.WaitForFlush();
+    check_base(block1, 0);
+
+    const uint256 block2{m_rng.rand256()};
+    for (size_t i{0}; i < outpoints.size() / 2; ++i) BOOST_CHECK(cache.SpendCoin(outpoints[i]));
+    cache.SetBestBlock(block2);
+    cache.Flush();
+    check_base(block2, outpoints.size() / 2);
+
+    // Batched reads through the cache combine cached and base coins in order.
+    const COutPoint cached{Txid::FromUint256(m_rng.rand256()), 0};
+    cache.AddCoin(cached, Coin{coin}, /*possible_overwrite=*/false);
+    const auto peeked{cache.PeekCoins(std::vector{outpoints.back(), cached, outpoints.front()})};
+    BOOST_REQUIRE_EQUAL(peeked.size(), 3U);
+    BOOST_CHECK(peeked[0] && *peeked[0] == coin);
+    BOOST_CHECK(peeked[1] && *peeked[1] == coin);
+    BOOST_CHECK(!peeked[2]);
+    BOOST_CHECK(cache.SpendCoin(cached));
+
+    // A flush that keeps the cache is written right away, after the pending one.
+    const uint256 block3{m_rng.rand256()};
+    for (size_t i{outpoints.size() / 2}; i < outpoints.size(); ++i) BOOST_CHECK(cache.SpendCoin(outpoints[i]));
+    cache.SetBestBlock(block3);
+    cache.Sync();
+    check_base(block3, outpoints.size());
+    BOOST_CHECK(!base.Cursor()->Valid());
+}
+
+BOOST_FIXTURE_TEST_CASE(ccoins_concurrent_readers, FlushTest)
+{
+    constexpr int NUM_COINS{2'000};
+    std::vector<COutPoint> outpoints;
+    for (int i{0}; i < NUM_COINS; ++i) outpoints.emplace_back(Txid::FromUint256(m_rng.rand256()), uint32_t(i));
+    const Coin coin{MakeCoin()};
+
+    CCoinsViewDB base{{.path = m_args.GetDataDirBase() / "ccoins_concurrent_readers", .cache_bytes = 1_MiB, .memory_only = true}, {}};
+    CCoinsViewCache cache{&base, /*deterministic=*/false, /*concurrent_reads=*/true};
+    cache.SetBestBlock(m_rng.rand256());
+
+    // Coins below this index have been added and are never spent, so readers
+    // must find them whether they are still in the cache or already flushed.
+    std::atomic<int> added{0};
+    std::atomic<bool> done{false};
+    std::atomic<int> missing{0};
+    std::vector<std::thread> readers;
+    for (int t{0}; t < 3; ++t) {
+        readers.emplace_back([&] {
+            while (!done) {
+                const int upper{added.load()};
+                for (int i{0}; i < upper; ++i) {
+                    const auto peeked{cache.PeekCoin(outpoints[i])};
+                    if (!peeked || !(*peeked == coin)) ++missing;
+                }
+                (void)cache.GetBestBlock();
+            }
+        });
+    }
+
+    for (int i{0}; i < NUM_COINS; ++i) {
+        cache.AddCoin(outpoints[i], Coin{coin}, /*possible_overwrite=*/false);
+        added = i + 1;
+        // Churn the cache with coins that are created and spent right away.
+        const COutPoint temp{Txid::FromUint256(m_rng.rand256()), 0};
+        cache.AddCoin(temp, Coin{coin}, /*possible_overwrite=*/false);
+        BOOST_CHECK(cache.SpendCoin(temp));
+        if (i % 100 == 99) cache.SetBestBlock(m_rng.rand256());
+        if (i % 250 == 249) (i % 500 == 499) ? cache.Flush() : cache.Sync();
+    }
+    done = true;
+    for (auto& reader : readers) reader.join();
+
+    BOOST_CHECK_EQUAL(missing.load(), 0);
+    cache.Flush();
+    for (const auto& outpoint : outpoints) BOOST_CHECK(*Assert(base.GetCoin(outpoint)) == coin);
+}
+
 BOOST_AUTO_TEST_CASE(coins_resource_is_used)
 {
     CCoinsMapMemoryResource resource;
@@ -1110,6 +1254,46 @@ BOOST_AUTO_TEST_CASE(coins_resource_is_used)
     PoolResourceTester::CheckAllDataAccountedFor(resource);
 }
 
+BOOST_AUTO_TEST_CASE(coins_map_matches_std_map)
+{
+    CCoinsMapMemoryResource resource;
+    CCoinsMap map{0, CCoinsMap::hasher{}, CCoinsMap::key_equal{}, &resource};
+    std::map<COutPoint, std::pair<CAmount, const CoinsCachePair*>> expected;
+
+    // Few distinct txids, so inserts and erases keep hitting the same keys,
+    // leaving tombstones behind and growing the index several times.
+    std::vector<Txid> txids;
+    for (int i{0}; i < 50; ++i) txids.push_back(Txid::FromUint256(m_rng.rand256()));
+    for (int i{0}; i < 20'000; ++i) {
+        const COutPoint outpoint{txids[m_rng.randrange(txids.size())], uint32_t(m_rng.randrange(100))};
+        if (m_rng.randbool()) {
+            const CAmount value{int64_t(m_rng.rand32())};
+            const auto [it, inserted]{map.try_emplace(outpoint, Coin{CTxOut{value, CScript{}}, 1, false})};
+            BOOST_CHECK_EQUAL(inserted, !expected.contains(outpoint));
+            if (inserted) expected.emplace(outpoint, std::pair{value, &*it});
+        } else {
+            BOOST_CHECK_EQUAL(map.erase(outpoint), expected.erase(outpoint));
+        }
+        BOOST_CHECK_EQUAL(map.size(), expected.size());
+    }
+
+    size_t count{0};
+    for (const auto& [outpoint, entry] : map) {
+        const auto& [value, node]{expected.at(outpoint)};
+        BOOST_CHECK_EQUAL(entry.coin.out.nValue, value);
+        ++count;
+    }
+    BOOST_CHECK_EQUAL(count, expected.size());
+    for (const auto& [outpoint, entry] : expected) {
+        // Entries never move, even when the index is rebuilt.
+        BOOST_CHECK_EQUAL(&*map.find(outpoint), entry.second);
+    }
+    map.clear();
+    BOOST_CHECK(map.begin() == map.end());
+    BOOST_CHECK(map.find(expected.begin()->first) == map.end());
+    PoolResourceTester::CheckAllDataAccountedFor(resource);
+}
+
 BOOST_AUTO_TEST_CASE(ccoins_addcoin_exception_keeps_usage_balanced)
 {
     CCoinsViewCacheTest cache{&CoinsViewEmpty::Get()};
@@ -6,6 +6,7 @@
 #include <chainparams.h>
 #include <coins.h>
 #include <consensus/validation.h>
+#include <crypto/muhash.h>
 #include <index/coinstatsindex.h>
 #include <interfaces/chain.h>
 #include <kernel/coinstats.h>
@@ -18,6 +19,7 @@
 #include <test/util/setup_common.h>
 #include <test/util/validation.h>
 #include <util/check.h>
+#include <util/threadpool.h>
 #include <validation.h>
 
 #include <boost/test/unit_test.hpp>
@@ -27,7 +29,10 @@
 #include <span>
 #include <vector>
 
+using kernel::ApplyCoinHash;
 using kernel::ChainstateRole;
+using kernel::CoinHashBatch;
+using kernel::RemoveCoinHash;
 
 BOOST_AUTO_TEST_SUITE(coinstatsindex_tests)
 
@@ -123,4 +128,49 @@ BOOST_FIXTURE_TEST_CASE(coinstatsindex_unclean_shutdown, TestChain100Setup)
     }
 }
 
+BOOST_FIXTURE_TEST_CASE(coin_hash_batch, BasicTestingSetup)
+{
+    // Enough coins for several full batches and a partial one.
+    std::vector<std::pair<COutPoint, Coin>> coins;
+    for (size_t i{0}; i < 3 * CoinHashBatch::BATCH_SIZE + 17; ++i) {
+        CScript script_pub_key;
+        script_pub_key << m_rng.randbytes(m_rng.randrange(40));
+        coins.emplace_back(COutPoint{Txid::FromUint256(m_rng.rand256()), uint32_t(m_rng.randrange(10))},
+                           Coin{CTxOut{int64_t(m_rng.randrange(MAX_MONEY)), script_pub_key}, int(m_rng.randrange(1000)), m_rng.randbool()});
+    }
+    const auto is_removed{[](size_t i) { return i % 3 == 0; }};
+
+    MuHash3072 expected;
+    for (size_t i{0}; i < coins.size(); ++i) {
+        const auto& [outpoint, coin]{coins[i]};
+        if (is_removed(i)) {
+            RemoveCoinHash(expected, outpoint, coin);
+        } else {
+            ApplyCoinHash(expected, outpoint, coin);
+        }
+    }
+    uint256 expected_hash;
+    expected.Finalize(expected_hash);
+
+    ThreadPool started_pool{"coinhash_test"};
+    started_pool.Start(2);
+    ThreadPool stopped_pool{"coinhash_none"};
+    for (ThreadPool* thread_pool : {static_cast<ThreadPool*>(nullptr), &started_pool, &stopped_pool}) {
+        MuHash3072 muhash;
+        CoinHashBatch batch{muhash, thread_pool};
+        for (size_t i{0}; i < coins.size(); ++i) {
+            const auto& [outpoint, coin]{coins[i]};
+            if (is_removed(i)) {
+                batch.Remove(outpoint, coin);
+            } else {
+                batch.Apply(outpoint, coin);
+            }
+        }
+        batch.Finish();
+        uint256 hash;
+        muhash.Finalize(hash);
+        BOOST_CHECK(hash == expected_hash);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
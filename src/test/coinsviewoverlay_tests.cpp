@@ -241,8 +241,12 @@ BOOST_AUTO_TEST_CASE(fetch_out_of_order_input_uses_normal_lookup)
     BOOST_CHECK(!view.HaveCoinInCache(out_of_order_input));
     BOOST_CHECK(!view.AccessCoin(out_of_order_input).IsSpent());
     BOOST_CHECK(view.HaveCoinInCache(out_of_order_input));
+    BOOST_CHECK_EQUAL(view.GetStats().prefetch_hits, 0U);
+    BOOST_CHECK_EQUAL(view.GetStats().prefetch_misses, 1U);
 
     CheckCache(block, view);
+    // Only the first input was still consumed from the prefetch queue.
+    BOOST_CHECK_EQUAL(view.GetStats().prefetch_hits, 1U);
 }
 
 // The ResetGuard returned by StartFetching must clear all per-block state when
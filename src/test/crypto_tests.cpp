@@ -849,6 +849,32 @@ BOOST_AUTO_TEST_CASE(chacha20_midblock)
     BOOST_CHECK(std::ranges::equal(std::span{block}.last(52), b3));
 }
 
+BOOST_AUTO_TEST_CASE(chacha20_implementations)
+{
+    // Compare the multi-block implementation against the standard one, including across a block counter overflow.
+    const auto key{m_rng.randbytes<std::byte>(ChaCha20::KEYLEN)};
+    for (const uint32_t start_block : {uint32_t{0}, uint32_t{0xfffffffa}}) {
+        const ChaCha20::Nonce96 nonce{m_rng.rand32(), m_rng.rand64()};
+        const auto input{m_rng.randbytes<std::byte>(64 * 21 + 13)};
+        std::vector<std::byte> out1(input.size()), out2(input.size()), stream1(1000), stream2(1000);
+
+        ChaCha20AutoDetect(chacha20_implementation::STANDARD);
+        ChaCha20 c20{key};
+        c20.Seek(nonce, start_block);
+        c20.Crypt(input, out1);
+        c20.Keystream(stream1);
+
+        ChaCha20AutoDetect(chacha20_implementation::USE_ALL);
+        c20.Seek(nonce, start_block);
+        c20.Crypt(input, out2);
+        c20.Keystream(stream2);
+
+        BOOST_CHECK(out1 == out2);
+        BOOST_CHECK(stream1 == stream2);
+    }
+    ChaCha20AutoDetect();
+}
+
 BOOST_AUTO_TEST_CASE(poly1305_testvector)
 {
     // RFC 7539, section 2.5.2.
@@ -1087,6 +1113,29 @@ BOOST_AUTO_TEST_CASE(sha256d64)
     }
 }
 
+BOOST_AUTO_TEST_CASE(sha256d_multi)
+{
+    for (const auto use_implementation : {sha256_implementation::STANDARD, sha256_implementation::USE_SSE4_AND_AVX2, sha256_implementation::USE_ALL}) {
+        SHA256AutoDetect(use_implementation);
+        for (int i = 0; i <= 20; ++i) {
+            // Mix lengths around the padding boundaries with longer messages.
+            std::vector<std::vector<unsigned char>> msgs(i);
+            std::vector<std::span<const unsigned char>> inputs;
+            for (auto& msg : msgs) {
+                msg = m_rng.randbytes<unsigned char>(m_rng.randbool() ? 50 + m_rng.randrange(20) : m_rng.randrange(600));
+                inputs.emplace_back(msg);
+            }
+            std::vector<unsigned char> out1(32 * i), out2(32 * i);
+            for (int j = 0; j < i; ++j) {
+                CHash256().Write(msgs[j]).Finalize({out1.data() + 32 * j, 32});
+            }
+            SHA256DMulti(out2.data(), inputs);
+            BOOST_CHECK(out1 == out2);
+        }
+    }
+    SHA256AutoDetect();
+}
+
 void CryptoTest::TestSHA3_256(const std::string& input, const std::string& output)
 {
     const auto in_bytes = ParseHex(input);
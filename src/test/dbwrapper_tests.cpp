@@ -11,6 +11,7 @@
 #include <util/string.h>
 
 #include <memory>
+#include <numeric>
 #include <ranges>
 
 #include <boost/test/unit_test.hpp>
@@ -194,6 +195,40 @@ BOOST_AUTO_TEST_CASE(dbwrapper_batch)
     }
 }
 
+BOOST_AUTO_TEST_CASE(dbwrapper_multiread)
+{
+    // Perform tests both obfuscated and non-obfuscated.
+    for (const bool obfuscate : {false, true}) {
+        CDBWrapper dbw({.path = m_args.GetDataDirBase() / "dbwrapper_multiread", .cache_bytes = 1_MiB, .memory_only = true, .wipe_data = true, .obfuscate = obfuscate});
+
+        std::vector<uint256> values;
+        for (uint8_t k{0}; k < 10; ++k) {
+            values.push_back(m_rng.rand256());
+            dbw.Write(k, values.back());
+        }
+
+        // Keys are looked up out of order, with missing and repeated keys mixed in.
+        const std::vector<uint8_t> keys{7, 42, 0, 9, 3, 3, 255};
+        const auto stats_before{dbw.GetStats()};
+        const auto read{dbw.MultiRead<uint256>(std::span<const uint8_t>{keys})};
+        const auto stats{dbw.GetStats()};
+        BOOST_CHECK_EQUAL(stats.reads - stats_before.reads, keys.size());
+        BOOST_CHECK_EQUAL(stats.reads_found - stats_before.reads_found, 5U);
+        BOOST_CHECK_EQUAL(stats.read_bytes - stats_before.read_bytes, 5U * uint256::size());
+        BOOST_CHECK_EQUAL(std::accumulate(stats.read_latency.begin(), stats.read_latency.end(), uint64_t{0}), stats.reads);
+        BOOST_REQUIRE_EQUAL(read.size(), keys.size());
+        for (size_t i{0}; i < keys.size(); ++i) {
+            if (keys[i] < values.size()) {
+                BOOST_REQUIRE(read[i]);
+                BOOST_CHECK_EQUAL(*read[i], values[keys[i]]);
+            } else {
+                BOOST_CHECK(!read[i]);
+            }
+        }
+        BOOST_CHECK(dbw.MultiRead<uint256>(std::span<const uint8_t>{}).empty());
+    }
+}
+
 BOOST_AUTO_TEST_CASE(dbwrapper_iterator)
 {
     // Perform tests both obfuscated and non-obfuscated.
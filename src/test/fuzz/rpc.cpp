@@ -118,6 +118,7 @@ const std::vector<std::string> RPC_COMMANDS_SAFE_FOR_FUZZING{
     "getaddrmaninfo",
     "getbestblockhash",
     "getblock",
+    "getblockcacheinfo",
     "getblockchaininfo",
     "getblockcount",
     "getblockfilter",
@@ -129,6 +130,7 @@ const std::vector<std::string> RPC_COMMANDS_SAFE_FOR_FUZZING{
     "getchaintips",
     "getchainstates",
     "getchaintxstats",
+    "getcoinscacheinfo",
     "getconnectioncount",
     "getdeploymentinfo",
     "getdescriptoractivity",
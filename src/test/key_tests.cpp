@@ -16,7 +16,9 @@
 #include <util/strencodings.h>
 #include <util/string.h>
 
+#include <array>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include <boost/test/unit_test.hpp>
@@ -335,6 +337,44 @@ BOOST_AUTO_TEST_CASE(bip340_test_vectors)
     }
 }
 
+BOOST_AUTO_TEST_CASE(batch_schnorr_verifier)
+{
+    BatchSchnorrVerifier batch;
+    BOOST_CHECK(batch.Verify());
+
+    // Sign with few keys, so that some signatures in the batch share a key.
+    std::vector<std::tuple<XOnlyPubKey, uint256, std::array<unsigned char, 64>>> sigs;
+    const std::vector<CKey> keys{GenerateRandomKey(), GenerateRandomKey(), GenerateRandomKey()};
+    for (int i = 0; i < 20; ++i) {
+        const CKey& key{keys[m_rng.randrange(keys.size())]};
+        const uint256 msg{m_rng.rand256()};
+        std::array<unsigned char, 64> sig;
+        BOOST_REQUIRE(key.SignSchnorr(msg, sig, nullptr, m_rng.rand256()));
+        sigs.emplace_back(XOnlyPubKey{key.GetPubKey()}, msg, sig);
+    }
+
+    for (const auto& [pubkey, msg, sig] : sigs) batch.Add(pubkey, msg, sig);
+    BOOST_CHECK_EQUAL(batch.size(), sigs.size());
+    BOOST_CHECK(batch.Verify());
+    BOOST_CHECK_EQUAL(batch.size(), 0U);
+
+    // A single invalid signature, wherever it is, fails the batch.
+    for (size_t bad = 0; bad < sigs.size(); ++bad) {
+        for (size_t i = 0; i < sigs.size(); ++i) {
+            auto [pubkey, msg, sig] = sigs[i];
+            if (i == bad) sig[m_rng.randrange(sig.size())] ^= 1;
+            batch.Add(pubkey, msg, sig);
+        }
+        BOOST_CHECK(!batch.Verify());
+    }
+
+    // So does an invalid public key.
+    const auto& [pubkey, msg, sig] = sigs[0];
+    batch.Add(pubkey, msg, sig);
+    batch.Add(XOnlyPubKey{}, msg, sig);
+    BOOST_CHECK(!batch.Verify());
+}
+
 BOOST_AUTO_TEST_CASE(key_ellswift)
 {
     for (const auto& secret : {strSecret1, strSecret2, strSecret1C, strSecret2C}) {
@@ -155,6 +155,54 @@ BOOST_AUTO_TEST_CASE(wait)
     waiter.join();
 }
 
+BOOST_AUTO_TEST_CASE(sock_poller)
+{
+    TcpSocketPair socks1{};
+    TcpSocketPair socks2{};
+    // Non-owning, like in Sock::Wait().
+    const std::shared_ptr<const Sock> receiver1{std::shared_ptr<const Sock>{}, &socks1.receiver};
+    const std::shared_ptr<const Sock> receiver2{std::shared_ptr<const Sock>{}, &socks2.receiver};
+
+    SockPoller poller;
+    Sock::EventsPerSock events_per_sock;
+    events_per_sock.emplace(receiver1, Sock::Events{Sock::RecvEvent});
+    events_per_sock.emplace(receiver2, Sock::Events{Sock::RecvEvent});
+
+    // Nothing to receive yet.
+    BOOST_REQUIRE(poller.WaitMany(0ms, events_per_sock));
+    BOOST_CHECK_EQUAL(events_per_sock.at(receiver1).occurred, 0);
+    BOOST_CHECK_EQUAL(events_per_sock.at(receiver2).occurred, 0);
+#ifdef USE_EPOLL
+    BOOST_CHECK_EQUAL(poller.RegisteredCount(), 2U);
+#endif
+
+    BOOST_REQUIRE_EQUAL(socks1.sender.Send("a", 1, 0), 1);
+    BOOST_REQUIRE(poller.WaitMany(1min, events_per_sock));
+    BOOST_CHECK_EQUAL(events_per_sock.at(receiver1).occurred, Sock::RecvEvent);
+    BOOST_CHECK_EQUAL(events_per_sock.at(receiver2).occurred, 0);
+
+    // The data has not been read, so it is reported again.
+    BOOST_REQUIRE(poller.WaitMany(0ms, events_per_sock));
+    BOOST_CHECK_EQUAL(events_per_sock.at(receiver1).occurred, Sock::RecvEvent);
+
+    // Changing the requested events of a registered socket.
+    events_per_sock.at(receiver2).requested = Sock::SendEvent;
+    BOOST_REQUIRE(poller.WaitMany(0ms, events_per_sock));
+    BOOST_CHECK_EQUAL(events_per_sock.at(receiver1).occurred, Sock::RecvEvent);
+    BOOST_CHECK_EQUAL(events_per_sock.at(receiver2).occurred, Sock::SendEvent);
+
+    // Sockets that are not waited for anymore are unregistered.
+    events_per_sock.erase(receiver1);
+    BOOST_REQUIRE(poller.WaitMany(0ms, events_per_sock));
+    BOOST_CHECK_EQUAL(events_per_sock.at(receiver2).occurred, Sock::SendEvent);
+#ifdef USE_EPOLL
+    BOOST_CHECK_EQUAL(poller.RegisteredCount(), 1U);
+#endif
+
+    poller.Clear();
+    BOOST_CHECK_EQUAL(poller.RegisteredCount(), 0U);
+}
+
 BOOST_AUTO_TEST_CASE(recv_until_terminator_limit)
 {
     constexpr auto timeout = 1min; // High enough so that it is never hit.
@@ -1329,4 +1329,31 @@ BOOST_AUTO_TEST_CASE(spends_witness_prog)
     }
 }
 
+BOOST_AUTO_TEST_CASE(make_transaction_refs)
+{
+    BOOST_CHECK(MakeTransactionRefs({}).empty());
+
+    std::vector<CMutableTransaction> txs(10);
+    for (size_t i{0}; i < txs.size(); ++i) {
+        auto& tx{txs[i]};
+        tx.vin.resize(1 + i % 3);
+        for (auto& in : tx.vin) {
+            in.prevout = COutPoint{Txid::FromUint256(m_rng.rand256()), uint32_t(i)};
+            in.scriptSig = CScript() << std::vector<unsigned char>(i * 20, 0x01);
+            // Give every other transaction a witness, some of them larger than a SHA256 block.
+            if (i % 2) in.scriptWitness.stack.push_back(m_rng.randbytes(i * 10));
+        }
+        tx.vout.emplace_back(i * COIN, CScript() << OP_TRUE);
+    }
+    const auto expected{txs};
+    const auto refs{MakeTransactionRefs(std::move(txs))};
+    BOOST_REQUIRE_EQUAL(refs.size(), expected.size());
+    for (size_t i{0}; i < refs.size(); ++i) {
+        const CTransaction tx{expected[i]};
+        BOOST_CHECK_EQUAL(refs[i]->HasWitness(), tx.HasWitness());
+        BOOST_CHECK_EQUAL(refs[i]->GetHash(), tx.GetHash());
+        BOOST_CHECK_EQUAL(refs[i]->GetWitnessHash(), tx.GetWitnessHash());
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
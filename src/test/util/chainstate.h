@@ -35,7 +35,8 @@ CreateAndActivateUTXOSnapshot(
     TestingSetup* fixture,
     F malleation = NoMalleation,
     bool reset_chainstate = false,
-    bool in_memory_chainstate = false)
+    bool in_memory_chainstate = false,
+    bool chunked = false)
 {
     node::NodeContext& node = fixture->m_node;
     fs::path root = fixture->m_path_root;
@@ -52,7 +53,8 @@ CreateAndActivateUTXOSnapshot(
                                          node.chainman->ActiveChainstate(),
                                          std::move(auto_outfile), // Will close auto_outfile.
                                          snapshot_path,
-                                         snapshot_path);
+                                         snapshot_path,
+                                         chunked);
     LogInfo("Wrote UTXO snapshot to %s: %s",
             fs::PathToString(snapshot_path.make_preferred()), result.write());
 
@@ -309,8 +309,9 @@ ChainTestingSetup::ChainTestingSetup(const ChainType chainType, TestOpts opts)
             .signals = m_node.validation_signals.get(),
             // Use no worker threads while fuzzing to avoid racy non-determinism
             // and dangling thread handles if AFL forks after initialization.
-            .worker_threads_num = EnableFuzzDeterminism() ? 0 : 2,
-            .prevoutfetch_threads_num = EnableFuzzDeterminism() ? 0 : 2,
+            // -par counts the calling thread, so the default of 3 means 2 worker threads.
+            .worker_threads_num = EnableFuzzDeterminism() ? 0 : static_cast<int>(m_args.GetIntArg("-par", 3)) - 1,
+            .prevoutfetch_threads_num = EnableFuzzDeterminism() ? 0 : m_args.GetArg<int32_t>("-prevoutfetchthreads").value_or(2),
         };
         if (opts.min_validation_cache) {
             chainman_opts.script_execution_cache_bytes = 0;
@@ -225,7 +225,7 @@ struct SnapshotTestSetup : TestChain100Setup {
     {
     }
 
-    std::tuple<Chainstate*, Chainstate*> SetupSnapshot()
+    std::tuple<Chainstate*, Chainstate*> SetupSnapshot(bool chunked = false)
     {
         ChainstateManager& chainman = *Assert(m_node.chainman);
 
@@ -290,12 +290,12 @@ struct SnapshotTestSetup : TestChain100Setup {
             this, [](AutoFile& auto_infile, SnapshotMetadata& metadata) {
                 // Coins count is larger than coins in file
                 metadata.m_coins_count += 1;
-        }));
+        }, /*reset_chainstate=*/false, /*in_memory_chainstate=*/false, chunked));
         BOOST_REQUIRE(!CreateAndActivateUTXOSnapshot(
             this, [](AutoFile& auto_infile, SnapshotMetadata& metadata) {
                 // Coins count is smaller than coins in file
                 metadata.m_coins_count -= 1;
-        }));
+        }, /*reset_chainstate=*/false, /*in_memory_chainstate=*/false, chunked));
         BOOST_REQUIRE(!CreateAndActivateUTXOSnapshot(
             this, [](AutoFile& auto_infile, SnapshotMetadata& metadata) {
                 // Wrong hash
@@ -307,7 +307,7 @@ struct SnapshotTestSetup : TestChain100Setup {
                 metadata.m_base_blockhash = uint256::ONE;
         }));
 
-        BOOST_REQUIRE(CreateAndActivateUTXOSnapshot(this));
+        BOOST_REQUIRE(CreateAndActivateUTXOSnapshot(this, NoMalleation, /*reset_chainstate=*/false, /*in_memory_chainstate=*/false, chunked));
         BOOST_CHECK(fs::exists(*node::FindAssumeutxoChainstateDir(chainman.m_options.datadir)));
 
         // Ensure our active chain is the snapshot chainstate.
@@ -457,6 +457,12 @@ BOOST_FIXTURE_TEST_CASE(chainstatemanager_activate_snapshot, SnapshotTestSetup)
     this->SetupSnapshot();
 }
 
+//! Test activation of a snapshot written in the chunked format.
+BOOST_FIXTURE_TEST_CASE(chainstatemanager_activate_snapshot_chunked, SnapshotTestSetup)
+{
+    this->SetupSnapshot(/*chunked=*/true);
+}
+
 //! Test LoadBlockIndex behavior when multiple chainstates are in use.
 //!
 //! - First, verify that setBlockIndexCandidates is as expected when using a single,
@@ -997,6 +1003,12 @@ BOOST_FIXTURE_TEST_CASE(chainstatemanager_args, BasicTestingSetup)
     BOOST_CHECK_EQUAL(get_valid_opts({"-prevoutfetchthreads=3"}).prevoutfetch_threads_num, 3);
     BOOST_CHECK_EQUAL(get_valid_opts({"-prevoutfetchthreads=100"}).prevoutfetch_threads_num, MAX_PREVOUTFETCH_THREADS);
     BOOST_CHECK(!get_opts({"-prevoutfetchthreads=-1"}));
+
+    BOOST_CHECK_EQUAL(get_valid_opts({}).block_lookahead, DEFAULT_BLOCK_LOOKAHEAD);
+    BOOST_CHECK_EQUAL(get_valid_opts({"-blocklookahead=0"}).block_lookahead, 0);
+    BOOST_CHECK_EQUAL(get_valid_opts({"-blocklookahead=4"}).block_lookahead, 4);
+    BOOST_CHECK_EQUAL(get_valid_opts({"-blocklookahead=100"}).block_lookahead, MAX_BLOCK_LOOKAHEAD);
+    BOOST_CHECK(!get_opts({"-blocklookahead=-1"}));
 }
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -17,6 +17,7 @@
 #include <util/threadnames.h>
 #include <util/vector.h>
 
+#include <algorithm>
 #include <cassert>
 #include <chrono>
 #include <cstdlib>
@@ -24,6 +25,7 @@
 #include <future>
 #include <iterator>
 #include <utility>
+#include <vector>
 
 static constexpr uint8_t DB_COIN{'C'};
 static constexpr uint8_t DB_BEST_BLOCK{'B'};
@@ -62,6 +64,12 @@ CCoinsViewDB::CCoinsViewDB(DBParams db_params, CoinsViewOptions options) :
 
 CCoinsViewDB::~CCoinsViewDB()
 {
+    if (const auto flush{WITH_LOCK(m_pending_mutex, return m_background_flush)}; flush.valid()) {
+        if (flush.wait_for(std::chrono::seconds{0}) != std::future_status::ready) {
+            LogInfo("Waiting for background chainstate flush of %s", fs::PathToString(m_db_params.path));
+        }
+        flush.wait();
+    }
     if (m_compaction.valid()) {
         if (m_compaction.wait_for(std::chrono::seconds{0}) != std::future_status::ready) {
             LogInfo("Waiting for background chainstate compaction of %s", fs::PathToString(m_db_params.path));
@@ -75,7 +83,7 @@ void CCoinsViewDB::ResizeCache(size_t new_cache_size)
     // We can't do this operation with an in-memory DB since we'll lose all the coins upon
     // reset.
     if (!m_db_params.memory_only) {
-        LOCK(m_db_mutex);
+        std::unique_lock lock{m_db_mutex};
         // Have to do a reset first to get the original `m_db` state to release its
         // filesystem lock.
         m_db.reset();
@@ -85,8 +93,26 @@ void CCoinsViewDB::ResizeCache(size_t new_cache_size)
     }
 }
 
+std::shared_ptr<const CCoinsViewDB::PendingFlush> CCoinsViewDB::GetPending() const
+{
+    return WITH_LOCK(m_pending_mutex, return m_pending);
+}
+
+//! Find a coin in a flush that is being written, spent coins included.
+static const Coin* FindPendingCoin(const std::vector<std::pair<COutPoint, Coin>>& coins, const COutPoint& outpoint)
+{
+    const auto it{std::lower_bound(coins.begin(), coins.end(), outpoint, [](const auto& entry, const COutPoint& key) { return entry.first < key; })};
+    return it != coins.end() && it->first == outpoint ? &it->second : nullptr;
+}
+
 std::optional<Coin> CCoinsViewDB::GetCoin(const COutPoint& outpoint) const
 {
+    if (const auto pending{GetPending()}) {
+        if (const Coin* coin{FindPendingCoin(pending->coins, outpoint)}) {
+            return coin->IsSpent() ? std::nullopt : std::optional{*coin};
+        }
+    }
+    std::shared_lock lock{m_db_mutex};
     if (Coin coin; m_db->Read(CoinEntry(&outpoint), coin)) {
         Assert(!coin.IsSpent()); // The UTXO database should never contain spent coins
         return coin;
@@ -99,12 +125,45 @@ std::optional<Coin> CCoinsViewDB::PeekCoin(const COutPoint& outpoint) const
     return GetCoin(outpoint);
 }
 
+std::vector<std::optional<Coin>> CCoinsViewDB::PeekCoins(std::span<const COutPoint> outpoints) const
+{
+    std::vector<std::optional<Coin>> coins(outpoints.size());
+    std::vector<CoinEntry> keys;
+    std::vector<size_t> key_indexes;
+    keys.reserve(outpoints.size());
+    key_indexes.reserve(outpoints.size());
+    const auto pending{GetPending()};
+    for (size_t i{0}; i < outpoints.size(); ++i) {
+        if (const Coin* coin{pending ? FindPendingCoin(pending->coins, outpoints[i]) : nullptr}) {
+            if (!coin->IsSpent()) coins[i] = *coin;
+        } else {
+            keys.emplace_back(&outpoints[i]);
+            key_indexes.push_back(i);
+        }
+    }
+    if (keys.empty()) return coins;
+
+    std::shared_lock lock{m_db_mutex};
+    auto db_coins{m_db->MultiRead<Coin>(std::span<const CoinEntry>{keys})};
+    for (size_t i{0}; i < keys.size(); ++i) {
+        if (db_coins[i]) Assert(!db_coins[i]->IsSpent()); // The UTXO database should never contain spent coins
+        coins[key_indexes[i]] = std::move(db_coins[i]);
+    }
+    return coins;
+}
+
 bool CCoinsViewDB::HaveCoin(const COutPoint& outpoint) const
 {
+    if (const auto pending{GetPending()}) {
+        if (const Coin* coin{FindPendingCoin(pending->coins, outpoint)}) return !coin->IsSpent();
+    }
+    std::shared_lock lock{m_db_mutex};
     return m_db->Exists(CoinEntry(&outpoint));
 }
 
 uint256 CCoinsViewDB::GetBestBlock() const {
+    if (const auto pending{GetPending()}) return pending->block_hash;
+    std::shared_lock lock{m_db_mutex};
     uint256 hashBestChain;
     if (!m_db->Read(DB_BEST_BLOCK, hashBestChain))
         return uint256();
@@ -112,6 +171,8 @@ uint256 CCoinsViewDB::GetBestBlock() const {
 }
 
 std::vector<uint256> CCoinsViewDB::GetHeadBlocks() const {
+    // Readers already see the state of a pending flush as complete.
+    if (GetPending()) return {};
     std::vector<uint256> vhashHeadBlocks;
     if (!m_db->Read(DB_HEAD_BLOCKS, vhashHeadBlocks)) {
         return std::vector<uint256>();
@@ -119,8 +180,97 @@ std::vector<uint256> CCoinsViewDB::GetHeadBlocks() const {
     return vhashHeadBlocks;
 }
 
+void CCoinsViewDB::WaitForFlush() const
+{
+    if (const auto flush{WITH_LOCK(m_pending_mutex, return m_background_flush)}; flush.valid()) flush.get();
+}
+
+void CCoinsViewDB::BulkWrite(CoinsViewCacheCursor& cursor)
+{
+    LOG_TIME_MILLIS_WITH_CATEGORY(strprintf("bulk write coins cache to disk (%d out of %d cached coins)",
+        cursor.GetDirtyCount(), cursor.GetTotalCount()), BCLog::BENCH);
+
+    std::vector<const CoinsCachePair*> entries;
+    entries.reserve(cursor.GetDirtyCount());
+    for (auto it{cursor.Begin()}; it != cursor.End(); it = it->second.Next()) {
+        if (it->second.IsDirty()) entries.push_back(it);
+    }
+    // Ordering by outpoint matches the order of the serialized keys, except
+    // for output indexes that take more than two bytes as a VARINT.
+    std::sort(entries.begin(), entries.end(), [](const CoinsCachePair* a, const CoinsCachePair* b) { return a->first < b->first; });
+
+    CDBBatch batch(*m_db);
+    for (const CoinsCachePair* entry : entries) {
+        CoinEntry key(&entry->first);
+        if (entry->second.coin.IsSpent()) {
+            batch.Erase(key);
+        } else {
+            batch.Write(key, entry->second.coin);
+        }
+        if (batch.ApproximateSize() > m_options.batch_write_bytes) {
+            m_db->WriteBatch(batch);
+            batch.Clear();
+        }
+    }
+    m_db->WriteBatch(batch);
+
+    for (auto it{cursor.Begin()}; it != cursor.End();) {
+        it = cursor.NextAndMaybeErase(*it);
+    }
+    LogDebug(BCLog::COINDB, "Bulk loaded %u transaction outputs to coin database...", (unsigned int)entries.size());
+}
+
+void CCoinsViewDB::MaybeWritePartialBatch(CDBBatch& batch)
+{
+    if (batch.ApproximateSize() <= m_options.batch_write_bytes) return;
+    LogDebug(BCLog::COINDB, "Writing partial batch of %.2f MiB\n", batch.ApproximateSize() / double(1_MiB));
+
+    m_db->WriteBatch(batch);
+    batch.Clear();
+    if (m_options.simulate_crash_ratio) {
+        static FastRandomContext rng;
+        if (rng.randrange(m_options.simulate_crash_ratio) == 0) {
+            LogError("Simulating a crash. Goodbye.");
+            _Exit(0);
+        }
+    }
+}
+
+void CCoinsViewDB::WritePending(const PendingFlush& pending)
+{
+    std::shared_lock lock{m_db_mutex};
+    LOG_TIME_MILLIS_WITH_CATEGORY(strprintf("write %d coins to disk in the background", pending.coins.size()), BCLog::BENCH);
+
+    CDBBatch batch(*m_db);
+    for (const auto& [outpoint, coin] : pending.coins) {
+        CoinEntry entry(&outpoint);
+        if (coin.IsSpent()) {
+            batch.Erase(entry);
+        } else {
+            batch.Write(entry, coin);
+        }
+        MaybeWritePartialBatch(batch);
+    }
+
+    // In the last batch, mark the database as consistent with block_hash again.
+    batch.Erase(DB_HEAD_BLOCKS);
+    batch.Write(DB_BEST_BLOCK, pending.block_hash);
+
+    LogDebug(BCLog::COINDB, "Writing final batch of %.2f MiB\n", batch.ApproximateSize() / double(1_MiB));
+    m_db->WriteBatch(batch);
+    LogDebug(BCLog::COINDB, "Committed %u changed transaction outputs to coin database in the background...", (unsigned int)pending.coins.size());
+    WITH_LOCK(m_pending_mutex, m_pending.reset());
+}
+
 void CCoinsViewDB::BatchWrite(CoinsViewCacheCursor& cursor, const uint256& block_hash)
 {
+    if (m_bulk_load) return BulkWrite(cursor);
+
+    // Each flush moves the best block markers on from where the previous one
+    // left them, so only one can be in progress.
+    WaitForFlush();
+    WITH_LOCK(m_pending_mutex, m_background_flush = {});
+
     CDBBatch batch(*m_db);
     size_t count = 0;
     const size_t dirty_count{cursor.GetDirtyCount()};
@@ -150,6 +300,28 @@ void CCoinsViewDB::BatchWrite(CoinsViewCacheCursor& cursor, const uint256& block
     batch.Erase(DB_BEST_BLOCK);
     batch.Write(DB_HEAD_BLOCKS, Vector(block_hash, old_tip));
 
+    if (m_options.background_flush && cursor.WillEraseAll()) {
+        // Record the transition before handing the coins off, so that a crash
+        // before they are all written is recovered like a partial write.
+        m_db->WriteBatch(batch);
+
+        auto pending{std::make_shared<PendingFlush>()};
+        pending->block_hash = block_hash;
+        pending->coins.reserve(dirty_count);
+        for (auto it{cursor.Begin()}; it != cursor.End(); it = cursor.NextAndMaybeErase(*it)) {
+            if (it->second.IsDirty()) pending->coins.emplace_back(it->first, std::move(it->second.coin));
+        }
+        std::sort(pending->coins.begin(), pending->coins.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        LOCK(m_pending_mutex);
+        m_pending = pending;
+        m_background_flush = std::async(std::launch::async, [this, pending] {
+            util::ThreadRename("utxoflush");
+            WritePending(*pending);
+        }).share();
+        return;
+    }
+
     for (auto it{cursor.Begin()}; it != cursor.End();) {
         if (it->second.IsDirty()) {
             CoinEntry entry(&it->first);
@@ -161,19 +333,7 @@ void CCoinsViewDB::BatchWrite(CoinsViewCacheCursor& cursor, const uint256& block
         }
         count++;
         it = cursor.NextAndMaybeErase(*it);
-        if (batch.ApproximateSize() > m_options.batch_write_bytes) {
-            LogDebug(BCLog::COINDB, "Writing partial batch of %.2f MiB\n", batch.ApproximateSize() / double(1_MiB));
-
-            m_db->WriteBatch(batch);
-            batch.Clear();
-            if (m_options.simulate_crash_ratio) {
-                static FastRandomContext rng;
-                if (rng.randrange(m_options.simulate_crash_ratio) == 0) {
-                    LogError("Simulating a crash. Goodbye.");
-                    _Exit(0);
-                }
-            }
-        }
+        MaybeWritePartialBatch(batch);
     }
 
     // In the last batch, mark the database as consistent with block_hash again.
@@ -195,6 +355,12 @@ std::optional<std::string> CCoinsViewDB::GetDBProperty(const std::string& proper
     return m_db->GetProperty(property);
 }
 
+DBStats CCoinsViewDB::GetDBStats() const
+{
+    std::shared_lock lock{m_db_mutex};
+    return m_db->GetStats();
+}
+
 std::shared_future<void> CCoinsViewDB::CompactFullAsync()
 {
     AssertLockHeld(::cs_main);
@@ -202,7 +368,7 @@ std::shared_future<void> CCoinsViewDB::CompactFullAsync()
     m_compaction = std::async(std::launch::async, [this] {
         try {
             util::ThreadRename("utxocompact");
-            LOCK(m_db_mutex);
+            std::shared_lock lock{m_db_mutex};
 
             LogDebug(BCLog::COINDB, "Starting chainstate compaction of %s", fs::PathToString(m_db_params.path));
             m_db->CompactFull();
@@ -239,6 +405,8 @@ private:
 
 std::unique_ptr<CCoinsViewCursor> CCoinsViewDB::Cursor() const
 {
+    // The cursor reads m_db directly.
+    WaitForFlush();
     auto i = std::make_unique<CCoinsViewDBCursor>(
         const_cast<CDBWrapper&>(*m_db).NewIterator(), GetBestBlock());
     /* It seems that there are no "const iterators" for LevelDB.  Since we
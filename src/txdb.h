@@ -18,18 +18,24 @@
 #include <future>
 #include <memory>
 #include <optional>
+#include <shared_mutex>
 #include <string>
 #include <vector>
 
 class COutPoint;
 class uint256;
 
+//! -dbbackgroundflush default
+static constexpr bool DEFAULT_DB_BACKGROUND_FLUSH{true};
+
 //! User-controlled performance and debug options.
 struct CoinsViewOptions {
     //! Maximum database write batch size in bytes.
     uint64_t batch_write_bytes{DEFAULT_DB_CACHE_BATCH};
     //! If non-zero, randomly exit when the database is flushed with (1/ratio) probability.
     int simulate_crash_ratio{0};
+    //! Write flushes that empty the coins cache on a background thread.
+    bool background_flush{DEFAULT_DB_BACKGROUND_FLUSH};
 };
 
 /** CCoinsView backed by the coin database (chainstate/) */
@@ -38,35 +44,85 @@ class CCoinsViewDB final : public CCoinsView
 protected:
     DBParams m_db_params;
     CoinsViewOptions m_options;
-    //! Prevents CompactFull() from using m_db while ResizeCache() replaces it.
-    Mutex m_db_mutex;
+    //! Prevents CompactFull() and readers on other threads from using m_db
+    //! while ResizeCache() replaces it.
+    mutable std::shared_mutex m_db_mutex;
     std::unique_ptr<CDBWrapper> m_db;
     std::shared_future<void> m_compaction;
+    bool m_bulk_load{false};
+
+    //! Dirty coins of a flush, in key order, and the block they belong to.
+    struct PendingFlush {
+        std::vector<std::pair<COutPoint, Coin>> coins;
+        uint256 block_hash;
+    };
+    mutable Mutex m_pending_mutex;
+    //! Flush being written on a background thread. Readers look coins up here
+    //! first, until all of them are in m_db.
+    std::shared_ptr<const PendingFlush> m_pending GUARDED_BY(m_pending_mutex);
+    std::shared_future<void> m_background_flush GUARDED_BY(m_pending_mutex);
+
+    std::shared_ptr<const PendingFlush> GetPending() const EXCLUSIVE_LOCKS_REQUIRED(!m_pending_mutex);
+    //! Write the dirty coins of a flush in key order, for BatchWrite during a bulk load.
+    void BulkWrite(CoinsViewCacheCursor& cursor);
+    //! Write a batch once it is large enough, possibly simulating a crash afterwards.
+    void MaybeWritePartialBatch(CDBBatch& batch);
+    //! Write a flush handed to the background thread, then mark the database as
+    //! consistent with its block.
+    void WritePending(const PendingFlush& pending) EXCLUSIVE_LOCKS_REQUIRED(!m_pending_mutex);
 public:
     explicit CCoinsViewDB(DBParams db_params, CoinsViewOptions options);
     ~CCoinsViewDB() override;
 
-    std::optional<Coin> GetCoin(const COutPoint& outpoint) const override;
-    std::optional<Coin> PeekCoin(const COutPoint& outpoint) const override;
-    bool HaveCoin(const COutPoint& outpoint) const override;
-    uint256 GetBestBlock() const override;
-    std::vector<uint256> GetHeadBlocks() const override;
-    void BatchWrite(CoinsViewCacheCursor& cursor, const uint256& block_hash) override;
+    std::optional<Coin> GetCoin(const COutPoint& outpoint) const override EXCLUSIVE_LOCKS_REQUIRED(!m_pending_mutex);
+    std::optional<Coin> PeekCoin(const COutPoint& outpoint) const override EXCLUSIVE_LOCKS_REQUIRED(!m_pending_mutex);
+    //! Read all coins not found in a pending flush from one database snapshot, in key order.
+    std::vector<std::optional<Coin>> PeekCoins(std::span<const COutPoint> outpoints) const override EXCLUSIVE_LOCKS_REQUIRED(!m_pending_mutex);
+    bool HaveCoin(const COutPoint& outpoint) const override EXCLUSIVE_LOCKS_REQUIRED(!m_pending_mutex);
+    uint256 GetBestBlock() const override EXCLUSIVE_LOCKS_REQUIRED(!m_pending_mutex);
+    std::vector<uint256> GetHeadBlocks() const override EXCLUSIVE_LOCKS_REQUIRED(!m_pending_mutex);
+    void BatchWrite(CoinsViewCacheCursor& cursor, const uint256& block_hash) override EXCLUSIVE_LOCKS_REQUIRED(!m_pending_mutex);
     //! Get a cursor to iterate over the whole state.
-    std::unique_ptr<CCoinsViewCursor> Cursor() const;
+    std::unique_ptr<CCoinsViewCursor> Cursor() const EXCLUSIVE_LOCKS_REQUIRED(!m_pending_mutex);
+
+    /**
+     * Wait until a flush handed to the background thread is fully written.
+     * Rethrows the error it failed with, if any.
+     *
+     * With background_flush set, BatchWrite() for a flush that empties the
+     * coins cache only records the transition to the new best block, takes
+     * the dirty coins and returns. They are written on a background thread
+     * while reads are answered from them. A crash in the meantime is
+     * recovered by replaying blocks, as after an interrupted BatchWrite().
+     */
+    void WaitForFlush() const EXCLUSIVE_LOCKS_REQUIRED(!m_pending_mutex);
 
     //! Whether an unsupported database format is used.
     bool NeedsUpgrade();
     size_t EstimateSize() const override;
 
     //! Dynamically alter the underlying leveldb cache size.
-    void ResizeCache(size_t new_cache_size) EXCLUSIVE_LOCKS_REQUIRED(cs_main, !m_db_mutex);
+    void ResizeCache(size_t new_cache_size) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 
     //! Perform a full compaction of the underlying LevelDB on a one-shot background thread.
-    std::shared_future<void> CompactFullAsync() EXCLUSIVE_LOCKS_REQUIRED(cs_main, !m_db_mutex);
+    std::shared_future<void> CompactFullAsync() EXCLUSIVE_LOCKS_REQUIRED(cs_main);
+
+    /**
+     * Start filling the database from a stream of coins in key order, as when
+     * loading a UTXO snapshot. Until FinishBulkLoad(), flushes write their coins
+     * in key order and leave the best block markers alone. The tables LevelDB
+     * writes then do not overlap each other, so they are placed directly in a
+     * lower level instead of being compacted over and over. The database is not
+     * consistent until a flush after FinishBulkLoad() records the best block.
+     */
+    void StartBulkLoad() { m_bulk_load = true; }
+    void FinishBulkLoad() { m_bulk_load = false; }
 
     //! Return an underlying LevelDB property value, if available.
     std::optional<std::string> GetDBProperty(const std::string& property);
+
+    //! Return the read and write counters of the underlying LevelDB.
+    DBStats GetDBStats() const;
 };
 
 #endif // BITCOIN_TXDB_H
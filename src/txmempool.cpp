@@ -771,6 +771,18 @@ std::optional<Coin> CCoinsViewMemPool::GetCoin(const COutPoint& outpoint) const
     return base->GetCoin(outpoint);
 }
 
+std::optional<Coin> CCoinsViewMemPool::PeekCoin(const COutPoint& outpoint) const
+{
+    if (auto it = m_temp_added.find(outpoint); it != m_temp_added.end()) {
+        return it->second;
+    }
+    if (CTransactionRef ptx = mempool.get(outpoint.hash)) {
+        if (outpoint.n < ptx->vout.size()) return Coin(ptx->vout[outpoint.n], MEMPOOL_HEIGHT, false);
+        return std::nullopt;
+    }
+    return base->PeekCoin(outpoint);
+}
+
 void CCoinsViewMemPool::PackageAddTransaction(const CTransactionRef& tx)
 {
     for (unsigned int n = 0; n < tx->vout.size(); ++n) {
@@ -0,0 +1,359 @@
+// Copyright (c) The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_UTIL_FLATNODEMAP_H
+#define BITCOIN_UTIL_FLATNODEMAP_H
+
+#include <util/check.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/** Hash map mimicking the parts of std::unordered_map used by the coins cache, built as an
+ *  open-addressing index over separately allocated nodes.
+ *
+ * - The index is an array of cache-line sized groups. Each group holds 7 one-byte tags (7
+ *   bits of the hash plus an occupied bit) next to 7 node pointers, so a lookup usually
+ *   touches one index cache line and then only the node whose tag matches.
+ * - Nodes are allocated one by one with Allocator and never move, so references, pointers
+ *   and iterators to elements stay valid until they are erased, even across rehashing.
+ *   This keeps intrusive structures pointing into the elements (like the coins cache's
+ *   flagged entry list) working.
+ * - There is no per-node link or cached hash, so a node is exactly sizeof(value_type).
+ * - Erasing leaves a tombstone unless the group still has an empty slot; tombstones are
+ *   reused by later inserts and dropped on rehash. The index never shrinks, except on
+ *   destruction.
+ * - Hash must not throw, as the hash of every element is recomputed when the index grows.
+ */
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+class FlatNodeMap
+{
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<const Key, T>;
+    using size_type = size_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using allocator_type = Allocator;
+
+    static_assert(std::is_same_v<typename std::allocator_traits<Allocator>::value_type, value_type>);
+    static_assert(std::is_nothrow_invocable_r_v<size_t, const Hash&, const Key&>, "Hash must not throw");
+
+private:
+    using AllocTraits = std::allocator_traits<Allocator>;
+
+    static constexpr size_t GROUP_SLOTS{7};
+    //! Tag of a slot that never held an element since the last rehash. Ends a probe sequence.
+    static constexpr uint8_t EMPTY{0};
+    //! Tag of a slot whose element was erased. Does not end a probe sequence.
+    static constexpr uint8_t DELETED{1};
+    //! Set in the tag of every occupied slot.
+    static constexpr uint8_t OCCUPIED{0x80};
+
+    struct alignas(64) Group {
+        std::array<uint8_t, GROUP_SLOTS> tags{};
+        std::array<value_type*, GROUP_SLOTS> nodes{};
+
+        bool HasEmpty() const noexcept
+        {
+            for (const uint8_t tag : tags) {
+                if (tag == EMPTY) return true;
+            }
+            return false;
+        }
+    };
+
+    Hash m_hash;
+    KeyEqual m_key_equal;
+    Allocator m_alloc;
+    //! Number of groups is zero or a power of two.
+    std::vector<Group> m_groups;
+    //! Number of elements.
+    size_t m_size{0};
+    //! Number of elements plus tombstones.
+    size_t m_used{0};
+
+    //! Maximum number of used slots for a given number of groups, a 7/8 load factor.
+    static constexpr size_t MaxUsed(size_t num_groups) noexcept { return num_groups * GROUP_SLOTS * 7 / 8; }
+
+    static constexpr uint8_t Tag(size_t hash) noexcept { return OCCUPIED | uint8_t(hash >> (sizeof(size_t) * 8 - 7)); }
+
+    /** Visit the groups in the probe sequence of a hash, until fn returns true. */
+    template <typename Fn>
+    void Probe(size_t hash, Fn&& fn) const
+    {
+        const size_t mask{m_groups.size() - 1};
+        size_t index{hash & mask};
+        for (size_t step{1};; ++step) {
+            if (fn(index)) return;
+            // Triangular numbers visit every group when the group count is a power of two.
+            index = (index + step) & mask;
+        }
+    }
+
+    /** Find the position of key, or return {m_groups.size(), 0}. */
+    std::pair<size_t, size_t> Locate(const Key& key, size_t hash) const
+    {
+        std::pair<size_t, size_t> ret{m_groups.size(), 0};
+        if (m_size == 0) return ret;
+        const uint8_t tag{Tag(hash)};
+        Probe(hash, [&](size_t index) {
+            const Group& group{m_groups[index]};
+            for (size_t slot{0}; slot < GROUP_SLOTS; ++slot) {
+                if (group.tags[slot] == tag && m_key_equal(group.nodes[slot]->first, key)) {
+                    ret = {index, slot};
+                    return true;
+                }
+            }
+            return group.HasEmpty();
+        });
+        return ret;
+    }
+
+    /** Find a free slot for a hash that is known not to be in the map. */
+    std::pair<size_t, size_t> LocateFree(size_t hash) const noexcept
+    {
+        std::pair<size_t, size_t> ret;
+        Probe(hash, [&](size_t index) {
+            const Group& group{m_groups[index]};
+            for (size_t slot{0}; slot < GROUP_SLOTS; ++slot) {
+                if (!(group.tags[slot] & OCCUPIED)) {
+                    ret = {index, slot};
+                    return true;
+                }
+            }
+            return false;
+        });
+        return ret;
+    }
+
+    /** Rebuild the index with num_groups groups, dropping all tombstones. */
+    void Rehash(size_t num_groups)
+    {
+        Assume(num_groups && (num_groups & (num_groups - 1)) == 0 && MaxUsed(num_groups) >= m_size);
+        std::vector<Group> old_groups(num_groups);
+        old_groups.swap(m_groups);
+        for (const Group& group : old_groups) {
+            for (size_t slot{0}; slot < GROUP_SLOTS; ++slot) {
+                if (!(group.tags[slot] & OCCUPIED)) continue;
+                const size_t hash{m_hash(group.nodes[slot]->first)};
+                const auto [index, new_slot]{LocateFree(hash)};
+                m_groups[index].tags[new_slot] = Tag(hash);
+                m_groups[index].nodes[new_slot] = group.nodes[slot];
+            }
+        }
+        m_used = m_size;
+    }
+
+    /** Make room for one more element. */
+    void Grow()
+    {
+        if (m_used < MaxUsed(m_groups.size())) return;
+        // Rehash in place if mostly tombstones are in the way, otherwise double the index.
+        size_t num_groups{std::max<size_t>(m_groups.size(), 1)};
+        while ((m_size + 1) * 2 > MaxUsed(num_groups)) num_groups *= 2;
+        Rehash(num_groups);
+    }
+
+    void DestroyNode(value_type* node) noexcept
+    {
+        AllocTraits::destroy(m_alloc, node);
+        AllocTraits::deallocate(m_alloc, node, 1);
+    }
+
+    template <bool CONST>
+    class Iter
+    {
+        friend class FlatNodeMap;
+        template <bool>
+        friend class Iter;
+        using GroupPtr = std::conditional_t<CONST, const Group*, Group*>;
+        GroupPtr m_group{nullptr};
+        GroupPtr m_end{nullptr};
+        size_t m_slot{0};
+
+        Iter(GroupPtr group, GroupPtr end, size_t slot) noexcept : m_group{group}, m_end{end}, m_slot{slot} {}
+
+        void SkipFree() noexcept
+        {
+            while (m_group != m_end && !(m_group->tags[m_slot] & OCCUPIED)) {
+                if (++m_slot == GROUP_SLOTS) {
+                    m_slot = 0;
+                    ++m_group;
+                }
+            }
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = FlatNodeMap::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<CONST, const value_type*, value_type*>;
+        using reference = std::conditional_t<CONST, const value_type&, value_type&>;
+
+        Iter() noexcept = default;
+        template <bool OTHER>
+            requires(CONST && !OTHER)
+        Iter(const Iter<OTHER>& other) noexcept : m_group{other.m_group}, m_end{other.m_end}, m_slot{other.m_slot} {}
+
+        reference operator*() const noexcept { return *m_group->nodes[m_slot]; }
+        pointer operator->() const noexcept { return m_group->nodes[m_slot]; }
+
+        Iter& operator++() noexcept
+        {
+            if (++m_slot == GROUP_SLOTS) {
+                m_slot = 0;
+                ++m_group;
+            }
+            SkipFree();
+            return *this;
+        }
+        Iter operator++(int) noexcept
+        {
+            Iter ret{*this};
+            ++*this;
+            return ret;
+        }
+
+        friend bool operator==(const Iter& a, const Iter& b) noexcept { return a.m_group == b.m_group && a.m_slot == b.m_slot; }
+    };
+
+public:
+    using iterator = Iter<false>;
+    using const_iterator = Iter<true>;
+
+    explicit FlatNodeMap(size_t bucket_count, const Hash& hash, const KeyEqual& key_equal, const Allocator& alloc)
+        : m_hash{hash}, m_key_equal{key_equal}, m_alloc{alloc}
+    {
+        if (bucket_count) reserve(bucket_count);
+    }
+
+    FlatNodeMap(const FlatNodeMap&) = delete;
+    FlatNodeMap& operator=(const FlatNodeMap&) = delete;
+
+    ~FlatNodeMap() { clear(); }
+
+    iterator begin() noexcept
+    {
+        iterator it{m_groups.data(), m_groups.data() + m_groups.size(), 0};
+        it.SkipFree();
+        return it;
+    }
+    const_iterator begin() const noexcept
+    {
+        const_iterator it{m_groups.data(), m_groups.data() + m_groups.size(), 0};
+        it.SkipFree();
+        return it;
+    }
+    iterator end() noexcept { return {m_groups.data() + m_groups.size(), m_groups.data() + m_groups.size(), 0}; }
+    const_iterator end() const noexcept { return {m_groups.data() + m_groups.size(), m_groups.data() + m_groups.size(), 0}; }
+
+    size_t size() const noexcept { return m_size; }
+    bool empty() const noexcept { return m_size == 0; }
+    allocator_type get_allocator() const noexcept { return m_alloc; }
+
+    //! Number of bytes allocated for the index, excluding the nodes.
+    size_t IndexBytes() const noexcept { return m_groups.size() * sizeof(Group); }
+
+    iterator find(const Key& key)
+    {
+        const auto [index, slot]{Locate(key, m_hash(key))};
+        return {m_groups.data() + index, m_groups.data() + m_groups.size(), slot};
+    }
+    const_iterator find(const Key& key) const
+    {
+        const auto [index, slot]{Locate(key, m_hash(key))};
+        return {m_groups.data() + index, m_groups.data() + m_groups.size(), slot};
+    }
+    size_t count(const Key& key) const { return find(key) != end(); }
+    bool contains(const Key& key) const { return find(key) != end(); }
+
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args)
+    {
+        const size_t hash{m_hash(key)};
+        if (auto [index, slot]{Locate(key, hash)}; index != m_groups.size()) {
+            return {iterator{m_groups.data() + index, m_groups.data() + m_groups.size(), slot}, false};
+        }
+        Grow();
+        value_type* node{AllocTraits::allocate(m_alloc, 1)};
+        try {
+            AllocTraits::construct(m_alloc, node, std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+        } catch (...) {
+            AllocTraits::deallocate(m_alloc, node, 1);
+            throw;
+        }
+        const auto [index, slot]{LocateFree(hash)};
+        Group& group{m_groups[index]};
+        if (group.tags[slot] == EMPTY) ++m_used;
+        group.tags[slot] = Tag(hash);
+        group.nodes[slot] = node;
+        ++m_size;
+        return {iterator{&group, m_groups.data() + m_groups.size(), slot}, true};
+    }
+
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(const Key& key, Args&&... args)
+    {
+        return try_emplace(key, std::forward<Args>(args)...);
+    }
+
+    T& operator[](const Key& key) { return try_emplace(key).first->second; }
+
+    //! Erase the element at pos, which must be valid. Unlike std::unordered_map, returns nothing.
+    void erase(const_iterator pos) noexcept
+    {
+        Group& group{m_groups[pos.m_group - m_groups.data()]};
+        DestroyNode(group.nodes[pos.m_slot]);
+        group.nodes[pos.m_slot] = nullptr;
+        // A group with an empty slot was never passed by a probe, so the slot can become empty
+        // again instead of a tombstone.
+        group.tags[pos.m_slot] = DELETED;
+        if (group.HasEmpty()) {
+            group.tags[pos.m_slot] = EMPTY;
+            --m_used;
+        }
+        --m_size;
+    }
+
+    size_t erase(const Key& key)
+    {
+        const auto it{find(key)};
+        if (it == end()) return 0;
+        erase(it);
+        return 1;
+    }
+
+    //! Destroy all elements, keeping the index allocated.
+    void clear() noexcept
+    {
+        if (m_used == 0) return;
+        for (Group& group : m_groups) {
+            for (size_t slot{0}; slot < GROUP_SLOTS; ++slot) {
+                if (group.tags[slot] & OCCUPIED) DestroyNode(group.nodes[slot]);
+            }
+            group = Group{};
+        }
+        m_size = m_used = 0;
+    }
+
+    //! Size the index so count elements fit without growing it.
+    void reserve(size_t count)
+    {
+        size_t num_groups{std::max<size_t>(m_groups.size(), 1)};
+        while (MaxUsed(num_groups) < count) num_groups *= 2;
+        if (num_groups != m_groups.size()) Rehash(num_groups);
+    }
+};
+
+#endif // BITCOIN_UTIL_FLATNODEMAP_H
@@ -19,6 +19,7 @@
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <typeinfo>
 #include <utility>
 #include <vector>
 
@@ -26,6 +27,10 @@
 #include <poll.h>
 #endif
 
+#ifdef USE_EPOLL
+#include <sys/epoll.h>
+#endif
+
 Sock::Sock(SOCKET s) : m_socket(s) {}
 
 Sock::Sock(Sock&& other)
@@ -423,6 +428,148 @@ bool Sock::operator==(SOCKET s) const
     return m_socket == s;
 };
 
+#ifdef USE_EPOLL
+static uint32_t EpollEvents(Sock::Event requested)
+{
+    // EPOLLERR and EPOLLHUP are always reported, like POLLERR and POLLHUP with poll(2).
+    uint32_t events{0};
+    if (requested & Sock::RecvEvent) events |= EPOLLIN;
+    if (requested & Sock::SendEvent) events |= EPOLLOUT;
+    return events;
+}
+
+SockPoller::SockPoller() : m_epoll_fd{epoll_create1(EPOLL_CLOEXEC)}
+{
+    if (m_epoll_fd == -1) {
+        LogWarning("Failed to create epoll instance, falling back to poll(2): %s", NetworkErrorString(WSAGetLastError()));
+    }
+}
+
+SockPoller::~SockPoller()
+{
+    if (m_epoll_fd != -1) close(m_epoll_fd);
+}
+
+bool SockPoller::Update(const Sock::EventsPerSock& events_per_sock)
+{
+    ++m_generation;
+
+    for (const auto& [sock, events] : events_per_sock) {
+        epoll_event ev{};
+        ev.events = EpollEvents(events.requested);
+        ev.data.fd = sock->m_socket;
+
+        auto [it, inserted]{m_registered.try_emplace(sock->m_socket, Registration{sock, events.requested, m_generation})};
+        if (inserted) {
+            if (epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, sock->m_socket, &ev) == SOCKET_ERROR) {
+                m_registered.erase(it);
+                return false;
+            }
+            continue;
+        }
+
+        Registration& reg{it->second};
+        if (reg.sock != sock) {
+            // A different object for the same descriptor, e.g. a Sock that was moved from.
+            // Register it anew, the kernel may refer to another file description now.
+            epoll_ctl(m_epoll_fd, EPOLL_CTL_DEL, sock->m_socket, nullptr);
+            reg = Registration{sock, events.requested, m_generation};
+            if (epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, sock->m_socket, &ev) == SOCKET_ERROR) {
+                m_registered.erase(it);
+                return false;
+            }
+            continue;
+        }
+
+        reg.generation = m_generation;
+        if (reg.requested != events.requested) {
+            if (epoll_ctl(m_epoll_fd, EPOLL_CTL_MOD, sock->m_socket, &ev) == SOCKET_ERROR) {
+                return false;
+            }
+            reg.requested = events.requested;
+        }
+    }
+
+    // Drop the sockets that are not waited for anymore. The socket is still open at this
+    // point, because the registration holds a reference to it.
+    for (auto it{m_registered.begin()}; it != m_registered.end();) {
+        if (it->second.generation != m_generation) {
+            epoll_ctl(m_epoll_fd, EPOLL_CTL_DEL, it->first, nullptr);
+            it = m_registered.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    return true;
+}
+
+bool SockPoller::WaitMany(std::chrono::milliseconds timeout, Sock::EventsPerSock& events_per_sock)
+{
+    assert(!events_per_sock.empty());
+
+    const bool plain_socks{std::ranges::all_of(events_per_sock, [](const auto& entry) {
+        return typeid(*entry.first) == typeid(Sock);
+    })};
+    if (m_epoll_fd == -1 || !plain_socks) {
+        Clear();
+        return events_per_sock.begin()->first->WaitMany(timeout, events_per_sock);
+    }
+
+    if (!Update(events_per_sock)) {
+        return false;
+    }
+
+    m_ready.resize(m_registered.size());
+    const int num_ready{epoll_wait(m_epoll_fd, m_ready.data(), m_ready.size(), count_milliseconds(timeout))};
+    if (num_ready == SOCKET_ERROR) {
+        return false;
+    }
+
+    for (auto& [sock, events] : events_per_sock) {
+        events.occurred = 0;
+    }
+    for (const epoll_event& ev : std::span{m_ready}.first(num_ready)) {
+        const auto& reg{m_registered.at(ev.data.fd)};
+        auto& events{events_per_sock.at(reg.sock)};
+        if (ev.events & EPOLLIN) {
+            events.occurred |= Sock::RecvEvent;
+        }
+        if (ev.events & EPOLLOUT) {
+            events.occurred |= Sock::SendEvent;
+        }
+        if (ev.events & (EPOLLERR | EPOLLHUP)) {
+            events.occurred |= Sock::ErrorEvent;
+        }
+    }
+
+    return true;
+}
+
+void SockPoller::Clear()
+{
+    for (const auto& [fd, reg] : m_registered) {
+        epoll_ctl(m_epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+    }
+    m_registered.clear();
+}
+
+size_t SockPoller::RegisteredCount() const { return m_registered.size(); }
+#else
+SockPoller::SockPoller() = default;
+SockPoller::~SockPoller() = default;
+
+bool SockPoller::WaitMany(std::chrono::milliseconds timeout, Sock::EventsPerSock& events_per_sock)
+{
+    assert(!events_per_sock.empty());
+    return events_per_sock.begin()->first->WaitMany(timeout, events_per_sock);
+}
+
+void SockPoller::Clear() {}
+
+size_t SockPoller::RegisteredCount() const { return 0; }
+#endif /* USE_EPOLL */
+
 std::string NetworkErrorString(int err)
 {
 #if defined(WIN32)
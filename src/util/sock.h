@@ -14,6 +14,11 @@
 #include <span>
 #include <string>
 #include <unordered_map>
+#include <vector>
+
+#ifdef USE_EPOLL
+#include <sys/epoll.h>
+#endif
 
 class CThreadInterrupt;
 
@@ -283,12 +288,89 @@ protected:
     SOCKET m_socket;
 
 private:
+    friend class SockPoller;
+
     /**
      * Close `m_socket` if it is not `INVALID_SOCKET`.
      */
     void Close();
 };
 
+/**
+ * Wait for readiness on a set of sockets that changes little between calls, like the
+ * connected peers of a socket handler loop.
+ *
+ * With `USE_EPOLL`, the sockets are registered with an epoll(7) instance and the
+ * registrations are kept across calls, so that only the sockets whose requested events
+ * changed are passed to the kernel and the cost of waiting depends on the number of
+ * ready sockets rather than on the number of watched sockets. Registrations are
+ * level-triggered, so a socket that is only partially drained is reported again by the
+ * next call, like with `Sock::WaitMany()`.
+ *
+ * Otherwise, or if any of the sockets is not a plain `Sock` (e.g. a mock in tests), this
+ * is equivalent to calling `Sock::WaitMany()` on the first socket.
+ *
+ * Not thread-safe, it is meant to be owned by a single socket handling thread.
+ */
+class SockPoller
+{
+public:
+    SockPoller();
+    ~SockPoller();
+
+    SockPoller(const SockPoller&) = delete;
+    SockPoller& operator=(const SockPoller&) = delete;
+
+    /**
+     * Same as `Sock::WaitMany()`. Sockets that were passed to the previous call but are
+     * missing from `events_per_sock` are unregistered and the references to them dropped.
+     * @param[in] timeout Wait this long for at least one of the requested events to occur.
+     * @param[in,out] events_per_sock Wait for the requested events on these sockets and set
+     * `occurred` for the events that actually occurred. Must not be empty.
+     * @return true on success (or timeout, if all `occurred` are returned as 0), false otherwise
+     */
+    [[nodiscard]] bool WaitMany(std::chrono::milliseconds timeout, Sock::EventsPerSock& events_per_sock);
+
+    /**
+     * Number of sockets currently registered with the kernel.
+     */
+    size_t RegisteredCount() const;
+
+    /**
+     * Unregister all sockets and drop the references to them, so that they can be closed.
+     */
+    void Clear();
+
+private:
+#ifdef USE_EPOLL
+    struct Registration {
+        /** Keeps the socket open, so its descriptor can not be reused while registered. */
+        std::shared_ptr<const Sock> sock;
+        Sock::Event requested;
+        /** Value of `m_generation` in the last call that included this socket. */
+        uint64_t generation;
+    };
+
+    /** Registered sockets, by descriptor. */
+    std::unordered_map<SOCKET, Registration> m_registered;
+
+    /** Incremented on every call, used to find sockets to unregister. */
+    uint64_t m_generation{0};
+
+    /** The epoll(7) instance, or -1 if it could not be created. */
+    int m_epoll_fd;
+
+    /** Buffer for the events returned by `epoll_wait(2)`, reused across calls. */
+    std::vector<epoll_event> m_ready;
+
+    /**
+     * Bring the kernel registrations in line with `events_per_sock`.
+     * @return false if registering a socket failed
+     */
+    bool Update(const Sock::EventsPerSock& events_per_sock);
+#endif
+};
+
 /** Return readable error string for a network error code */
 std::string NetworkErrorString(int err);
 
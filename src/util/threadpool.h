@@ -12,10 +12,12 @@
 #include <util/thread.h>
 
 #include <algorithm>
+#include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <functional>
 #include <future>
-#include <queue>
+#include <memory>
 #include <ranges>
 #include <thread>
 #include <type_traits>
@@ -23,12 +25,21 @@
 #include <vector>
 
 /**
- * @brief Fixed-size thread pool for running arbitrary tasks concurrently.
+ * @brief Fixed-size, work-stealing thread pool for running arbitrary tasks concurrently.
  *
  * The thread pool maintains a set of worker threads that consume and execute
  * tasks submitted through Submit(). Once started, tasks can be queued and
  * processed asynchronously until Stop() is called.
  *
+ * ### Scheduling
+ * Every worker owns a task deque. Tasks submitted from outside the pool are
+ * spread round-robin over the deques, while tasks submitted from a worker are
+ * pushed onto that worker's own deque. A worker pops from the back of its own
+ * deque and, once it runs dry, steals from the front of the other deques
+ * before going to sleep. This lets unrelated producers (e.g. script
+ * verification and prevout prefetching) share one set of threads without
+ * contending on a single queue lock.
+ *
  * ### Thread-safety and lifecycle
  * - `Start()` and `Stop()` must be called from a controller (non-worker) thread.
  *   Calling `Stop()` from a worker thread will deadlock, as it waits for all
@@ -47,9 +58,31 @@
 class ThreadPool
 {
 private:
+    //! Task deque owned by a single worker. Other threads may steal from it.
+    struct WorkerQueue {
+        Mutex m_mutex;
+        std::deque<std::packaged_task<void()>> m_tasks GUARDED_BY(m_mutex);
+    };
+
+    //! Identifies the pool and deque owned by the current thread, if it is a worker.
+    //! Zero-initialized (no pool) for any other thread.
+    struct WorkerId {
+        const ThreadPool* pool;
+        size_t index;
+    };
+    static inline thread_local WorkerId g_current_worker;
+
     std::string m_name;
     Mutex m_mutex;
-    std::queue<std::packaged_task<void()>> m_work_queue GUARDED_BY(m_mutex);
+    //! One deque per worker. Only resized by Start() while no workers are alive, so workers may
+    //! access it without holding m_mutex. Any other thread must hold m_mutex.
+    std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+    //! Deque receiving the next task submitted from outside the pool.
+    size_t m_next_queue GUARDED_BY(m_mutex){0};
+    //! Number of tasks queued across all deques. Incremented before a task is pushed and
+    //! decremented after it is popped, so it never undercounts. It is only incremented while
+    //! holding m_mutex, which lets sleeping workers rely on it without missing a wakeup.
+    std::atomic<size_t> m_queued{0};
     std::condition_variable m_cv;
     // Note: m_interrupt must be guarded by m_mutex, and cannot be replaced by an unguarded atomic bool.
     // This ensures threads blocked on m_cv reliably observe the change and proceed correctly without missing signals.
@@ -57,31 +90,60 @@ private:
     bool m_interrupt GUARDED_BY(m_mutex){false};
     std::vector<std::thread> m_workers GUARDED_BY(m_mutex);
 
-    void WorkerThread() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    //! Push a task onto the caller's own deque if it is one of our workers, otherwise round-robin.
+    void Enqueue(std::packaged_task<void()> task) EXCLUSIVE_LOCKS_REQUIRED(m_mutex)
     {
-        WAIT_LOCK(m_mutex, wait_lock);
-        for (;;) {
-            std::packaged_task<void()> task;
-            {
-                // Wait only if needed; avoid sleeping when a new task was submitted while we were processing another one.
-                if (!m_interrupt && m_work_queue.empty()) {
-                    // Block until the pool is interrupted or a task is available.
-                    m_cv.wait(wait_lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return m_interrupt || !m_work_queue.empty(); });
-                }
-
-                // If stopped and no work left, exit worker
-                if (m_interrupt && m_work_queue.empty()) {
-                    return;
-                }
-
-                task = std::move(m_work_queue.front());
-                m_work_queue.pop();
+        const size_t index{g_current_worker.pool == this ? g_current_worker.index : m_next_queue++ % m_queues.size()};
+        m_queued.fetch_add(1, std::memory_order_relaxed);
+        auto& queue{*m_queues[index]};
+        LOCK(queue.m_mutex);
+        queue.m_tasks.emplace_back(std::move(task));
+    }
+
+    /**
+     * Pop a task, visiting the deques in order starting at `first`.
+     * If `owner` is set, the first deque belongs to the caller and is popped from the back,
+     * otherwise all deques are stolen from the front.
+     * Returns an invalid task if all deques are empty.
+     */
+    std::packaged_task<void()> TakeTask(size_t first, bool owner) noexcept
+    {
+        std::packaged_task<void()> task;
+        const size_t num_queues{m_queues.size()};
+        for (size_t i{0}; i < num_queues; ++i) {
+            auto& queue{*m_queues[(first + i) % num_queues]};
+            LOCK(queue.m_mutex);
+            if (queue.m_tasks.empty()) continue;
+            if (owner && i == 0) {
+                task = std::move(queue.m_tasks.back());
+                queue.m_tasks.pop_back();
+            } else {
+                task = std::move(queue.m_tasks.front());
+                queue.m_tasks.pop_front();
             }
+            m_queued.fetch_sub(1, std::memory_order_relaxed);
+            break;
+        }
+        return task;
+    }
 
-            {
-                // Execute the task without the lock
-                REVERSE_LOCK(wait_lock, m_mutex);
+    void WorkerThread(size_t index) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        g_current_worker = {this, index};
+        for (;;) {
+            // Drain our own deque first, then help the other workers before going to sleep.
+            if (auto task{TakeTask(index, /*owner=*/true)}; task.valid()) {
                 task();
+                continue;
+            }
+
+            WAIT_LOCK(m_mutex, wait_lock);
+            // Block until the pool is interrupted or a task is available.
+            m_cv.wait(wait_lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return m_interrupt || m_queued.load(std::memory_order_relaxed) > 0; });
+
+            // If stopped and no work left, exit worker
+            if (m_interrupt && m_queued.load(std::memory_order_relaxed) == 0) {
+                return;
             }
         }
     }
@@ -109,10 +171,17 @@ public:
         if (m_interrupt) throw std::runtime_error("Thread pool has been interrupted or is stopping");
         if (!m_workers.empty()) throw std::runtime_error("Thread pool already started");
 
+        // Create a deque per worker before any worker can access them
+        m_queues.clear();
+        for (int i = 0; i < num_workers; i++) {
+            m_queues.emplace_back(std::make_unique<WorkerQueue>());
+        }
+        m_next_queue = 0;
+
         // Create workers
         m_workers.reserve(num_workers);
         for (int i = 0; i < num_workers; i++) {
-            m_workers.emplace_back(&util::TraceThread, strprintf("%s.%02d", m_name, i), [this] { WorkerThread(); });
+            m_workers.emplace_back(&util::TraceThread, strprintf("%s.%02d", m_name, i), [this, i] { WorkerThread(i); });
         }
     }
 
@@ -147,7 +216,7 @@ public:
 
         // Since we currently wait for tasks completion, sanity-check empty queue
         LOCK(m_mutex);
-        Assume(m_work_queue.empty());
+        Assume(m_queued.load() == 0);
         // Re-allow Start() now that all workers have exited
         m_interrupt = false;
     }
@@ -190,7 +259,7 @@ public:
             if (m_workers.empty()) return util::Unexpected{SubmitError::Inactive};
             if (m_interrupt) return util::Unexpected{SubmitError::Interrupted};
 
-            m_work_queue.emplace(std::move(task));
+            Enqueue(std::packaged_task<void()>{std::move(task)});
         }
         m_cv.notify_one();
         return {std::move(future)};
@@ -206,7 +275,7 @@ public:
      *         - SubmitError::Interrupted: Pool task acceptance has been interrupted.
      *
      * This is more efficient when submitting many tasks at once, since
-     * the queue lock is only taken once internally and all worker threads are
+     * the pool lock is only taken once internally and all worker threads are
      * notified. For single tasks, Submit() is preferred since only one worker
      * thread is notified.
      *
@@ -229,7 +298,7 @@ public:
             for (auto&& fn : fns) {
                 PackagedTask<std::ranges::range_reference_t<R>> task{std::move(fn)};
                 futures.emplace_back(task.get_future());
-                m_work_queue.emplace(std::move(task));
+                Enqueue(std::packaged_task<void()>{std::move(task)});
             }
         }
         m_cv.notify_all();
@@ -238,19 +307,12 @@ public:
 
     /**
      * @brief Execute a single queued task synchronously.
-     * Removes one task from the queue and executes it on the calling thread.
+     * Steals the oldest task from any worker's deque and executes it on the calling thread.
      */
     bool ProcessTask() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
     {
-        std::packaged_task<void()> task;
-        {
-            LOCK(m_mutex);
-            if (m_work_queue.empty()) return false;
-
-            // Pop the task
-            task = std::move(m_work_queue.front());
-            m_work_queue.pop();
-        }
+        auto task{WITH_LOCK(m_mutex, return TakeTask(/*first=*/0, /*owner=*/false))};
+        if (!task.valid()) return false;
         task();
         return true;
     }
@@ -271,9 +333,9 @@ public:
         m_cv.notify_all();
     }
 
-    size_t WorkQueueSize() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    size_t WorkQueueSize() const noexcept
     {
-        return WITH_LOCK(m_mutex, return m_work_queue.size());
+        return m_queued.load(std::memory_order_relaxed);
     }
 
     size_t WorkersCount() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
@@ -43,6 +43,7 @@
 #include <script/script.h>
 #include <script/sigcache.h>
 #include <signet.h>
+#include <streams.h>
 #include <tinyformat.h>
 #include <txdb.h>
 #include <txmempool.h>
@@ -70,12 +71,14 @@
 #include <cassert>
 #include <chrono>
 #include <deque>
+#include <future>
 #include <numeric>
 #include <optional>
 #include <ranges>
 #include <span>
 #include <string>
 #include <tuple>
+#include <unordered_set>
 #include <utility>
 
 using kernel::CCoinsStats;
@@ -1860,16 +1863,13 @@ CoinsViews::CoinsViews(DBParams db_params, CoinsViewOptions options)
     : m_dbview{std::move(db_params), std::move(options)},
       m_catcherview(&m_dbview) {}
 
-void CoinsViews::InitCache(int32_t prevoutfetch_threads)
+void CoinsViews::InitCache(std::shared_ptr<ThreadPool> thread_pool, int32_t prevoutfetch_threads)
 {
     AssertLockHeld(::cs_main);
-    m_cacheview = std::make_unique<CCoinsViewCache>(&m_catcherview);
-    auto thread_pool{std::make_shared<ThreadPool>("prevout")};
-    if (prevoutfetch_threads > 0) {
-        thread_pool->Start(prevoutfetch_threads);
-        LogInfo("Block input prevout fetching uses %d additional threads", prevoutfetch_threads);
-    }
-    m_connect_block_view = std::make_unique<CoinsViewOverlay>(&*m_cacheview, std::move(thread_pool));
+    // Allow RPC, REST and prevout fetching threads to look up coins without cs_main.
+    m_cacheview = std::make_unique<CCoinsViewCache>(&m_catcherview, /*deterministic=*/false, /*concurrent_reads=*/true);
+    m_connect_block_view = std::make_unique<CoinsViewOverlay>(&*m_cacheview, std::move(thread_pool),
+                                                              /*deterministic=*/false, std::max(prevoutfetch_threads, 0));
 }
 
 Chainstate::Chainstate(
@@ -1945,7 +1945,7 @@ void Chainstate::InitCoinsCache(size_t cache_size_bytes)
     AssertLockHeld(::cs_main);
     assert(m_coins_views != nullptr);
     m_coinstip_cache_size_bytes = cache_size_bytes;
-    m_coins_views->InitCache(m_chainman.m_options.prevoutfetch_threads_num);
+    m_coins_views->InitCache(m_chainman.m_thread_pool, m_chainman.m_options.prevoutfetch_threads_num);
 }
 
 // Lock-free: depends on `m_cached_is_ibd`, which is latched by `UpdateIBDStatus()`.
@@ -2023,11 +2023,11 @@ void UpdateCoins(const CTransaction& tx, CCoinsViewCache& inputs, CTxUndo &txund
     AddCoins(inputs, tx, nHeight);
 }
 
-std::optional<std::pair<ScriptError, std::string>> CScriptCheck::operator()() {
+std::optional<std::pair<ScriptError, std::string>> CScriptCheck::Check(BatchSchnorrVerifier* batch) {
     const CScript &scriptSig = ptxTo->vin[nIn].scriptSig;
     const CScriptWitness *witness = &ptxTo->vin[nIn].scriptWitness;
     ScriptError error{SCRIPT_ERR_UNKNOWN_ERROR};
-    if (VerifyScript(scriptSig, m_tx_out.scriptPubKey, witness, m_flags, CachingTransactionSignatureChecker(ptxTo, nIn, m_tx_out.nValue, cacheStore, *m_signature_cache, *txdata), &error)) {
+    if (VerifyScript(scriptSig, m_tx_out.scriptPubKey, witness, m_flags, CachingTransactionSignatureChecker(ptxTo, nIn, m_tx_out.nValue, cacheStore, *m_signature_cache, *txdata, batch), &error)) {
         return std::nullopt;
     } else {
         auto debug_str = strprintf("input %i of %s (wtxid %s), spending %s:%i", nIn, ptxTo->GetHash().ToString(), ptxTo->GetWitnessHash().ToString(), ptxTo->vin[nIn].prevout.hash.ToString(), ptxTo->vin[nIn].prevout.n);
@@ -2809,6 +2809,9 @@ bool Chainstate::FlushStateToDisk(
             if (fFlushForPrune) {
                 LOG_TIME_MILLIS_WITH_CATEGORY("unlink pruned files", BCLog::BENCH);
 
+                // A crash before a background flush is complete is recovered by
+                // replaying blocks, which must not be pruned before then.
+                CoinsDB().WaitForFlush();
                 m_blockman.UnlinkPrunedFiles(setFilesToPrune);
             }
 
@@ -2823,6 +2826,9 @@ bool Chainstate::FlushStateToDisk(
                 }
                 // Flush the chainstate (which may refer to block index entries).
                 empty_cache ? CoinsTip().Flush() : CoinsTip().Sync();
+                // Only flushes that make room in the cache may finish writing
+                // in the background while blocks keep being connected.
+                if (!fCacheLarge && !fCacheCritical) CoinsDB().WaitForFlush();
                 m_last_flushed_block = m_blockman.LookupBlockIndex(CoinsTip().GetBestBlock());
                 full_flush_completed = true;
                 TRACEPOINT(utxocache, flush,
@@ -3036,11 +3042,16 @@ bool Chainstate::ConnectTip(
     // Read block from disk.
     const auto time_1{SteadyClock::now()};
     if (!block_to_connect) {
-        std::shared_ptr<CBlock> pblockNew = std::make_shared<CBlock>();
-        if (!m_blockman.ReadBlock(*pblockNew, *pindexNew)) {
-            return FatalError(m_chainman.GetNotifications(), state, _("Failed to read block."));
+        if (auto lookahead_block{TakeLookaheadBlock(*pindexNew)}) {
+            LogDebug(BCLog::BENCH, "  - Using lookahead block\n");
+            block_to_connect = std::move(lookahead_block);
+        } else {
+            std::shared_ptr<CBlock> pblockNew = std::make_shared<CBlock>();
+            if (!m_blockman.ReadBlock(*pblockNew, *pindexNew)) {
+                return FatalError(m_chainman.GetNotifications(), state, _("Failed to read block."));
+            }
+            block_to_connect = std::move(pblockNew);
         }
-        block_to_connect = std::move(pblockNew);
     } else {
         LogDebug(BCLog::BENCH, "  - Using cached block\n");
     }
@@ -3051,6 +3062,9 @@ bool Chainstate::ConnectTip(
     // num_blocks_total may be zero until the ConnectBlock() call below.
     LogDebug(BCLog::BENCH, "  - Load block from disk: %.2fms\n",
              Ticks<MillisecondsDouble>(time_2 - time_1));
+    const auto view_stats_before{ConnectBlockView().GetStats()};
+    const auto tip_stats_before{CoinsTip().GetStats()};
+    const auto db_stats_before{CoinsDB().GetDBStats()};
     {
         CoinsViewOverlay& view{*m_coins_views->m_connect_block_view};
         const auto reset_guard{view.StartFetching(*block_to_connect)};
@@ -3089,6 +3103,28 @@ bool Chainstate::ConnectTip(
              Ticks<MillisecondsDouble>(time_5 - time_4),
              Ticks<SecondsDouble>(m_chainman.time_chainstate),
              Ticks<MillisecondsDouble>(m_chainman.time_chainstate) / m_chainman.num_blocks_total);
+    if (util::log::ShouldDebugLog(BCLog::BENCH)) {
+        const auto view_stats{ConnectBlockView().GetStats()};
+        const auto tip_stats{CoinsTip().GetStats()};
+        const auto db_stats{CoinsDB().GetDBStats()};
+        const uint64_t tip_lookups{tip_stats.hits + tip_stats.misses};
+        LogDebug(BCLog::BENCH, "  - Coins: %u lookups (%u prefetched, %u not), tip cache %u hits, %u misses, db %u reads (%u found, %u bytes, %.2fms), %u writes (%u bytes, %.2fms) [tip cache %.1f%% hits, db %u reads (%.2fs), %u writes (%.2fs)]\n",
+                 (view_stats.hits + view_stats.misses) - (view_stats_before.hits + view_stats_before.misses),
+                 view_stats.prefetch_hits - view_stats_before.prefetch_hits,
+                 view_stats.prefetch_misses - view_stats_before.prefetch_misses,
+                 tip_stats.hits - tip_stats_before.hits,
+                 tip_stats.misses - tip_stats_before.misses,
+                 db_stats.reads - db_stats_before.reads,
+                 db_stats.reads_found - db_stats_before.reads_found,
+                 db_stats.read_bytes - db_stats_before.read_bytes,
+                 Ticks<MillisecondsDouble>(db_stats.read_time - db_stats_before.read_time),
+                 db_stats.batches_written - db_stats_before.batches_written,
+                 db_stats.write_bytes - db_stats_before.write_bytes,
+                 Ticks<MillisecondsDouble>(db_stats.write_time - db_stats_before.write_time),
+                 tip_lookups == 0 ? 0.0 : 100.0 * tip_stats.hits / tip_lookups,
+                 db_stats.reads, Ticks<SecondsDouble>(db_stats.read_time),
+                 db_stats.batches_written, Ticks<SecondsDouble>(db_stats.write_time));
+    }
     // Remove conflicting transactions from the mempool.;
     if (m_mempool) {
         m_mempool->removeForBlock(block_to_connect->vtx, pindexNew->nHeight);
@@ -3127,6 +3163,81 @@ bool Chainstate::ConnectTip(
     return true;
 }
 
+/**
+ * Read a lookahead block from disk and check it. The outcome of CheckBlock() is
+ * cached in the block, and failures are reported again by ConnectBlock(). The
+ * coins the block spends are read from the database once so that they are in
+ * the LevelDB and OS caches by the time the block is connected.
+ */
+static std::shared_ptr<const CBlock> PrepareLookaheadBlock(const node::BlockManager& blockman,
+                                                           const Consensus::Params& consensus,
+                                                           const CCoinsView& coins_db,
+                                                           const FlatFilePos& pos,
+                                                           const uint256& hash)
+{
+    auto block{std::make_shared<CBlock>()};
+    if (!blockman.ReadBlock(*block, pos, hash)) return nullptr;
+
+    BlockValidationState state;
+    CheckBlock(*block, state, consensus);
+
+    try {
+        // Outputs created earlier in the same block are not in the database.
+        std::unordered_set<Txid, SaltedTxidHasher> earlier_txids;
+        earlier_txids.reserve(block->vtx.size());
+        for (const auto& tx : block->vtx | std::views::drop(1)) {
+            for (const auto& input : tx->vin) {
+                if (!earlier_txids.contains(input.prevout.hash)) (void)coins_db.PeekCoin(input.prevout);
+            }
+            earlier_txids.emplace(tx->GetHash());
+        }
+    } catch (const std::exception& e) {
+        // Read errors are handled when the coins are accessed during ConnectBlock().
+        LogDebug(BCLog::VALIDATION, "Failed to warm up inputs of lookahead block %s: %s\n", hash.ToString(), e.what());
+    }
+    return block;
+}
+
+void Chainstate::ScheduleBlockLookahead(std::span<CBlockIndex* const> blocks)
+{
+    AssertLockHeld(cs_main);
+    // The block about to be connected only stays in the lookahead if it was prepared already.
+    const bool prepared_current{!blocks.empty() && !m_block_lookahead.empty() && m_block_lookahead.front().pindex == blocks.front()};
+    if (!blocks.empty() && !prepared_current) blocks = blocks.subspan(1);
+
+    // Keep the lookahead blocks that are still upcoming. This is a prefix of blocks, unless
+    // the path to the most-work chain changed.
+    size_t num_kept{0};
+    while (num_kept < m_block_lookahead.size() && num_kept < blocks.size() &&
+           m_block_lookahead[num_kept].pindex == blocks[num_kept]) {
+        ++num_kept;
+    }
+    while (m_block_lookahead.size() > num_kept) m_block_lookahead.pop_back();
+
+    const size_t depth{std::min(blocks.size(), size_t(std::max(m_chainman.m_options.block_lookahead, 0)) + prepared_current)};
+    for (size_t i{m_block_lookahead.size()}; i < depth; ++i) {
+        const CBlockIndex& index{*blocks[i]};
+        if (!(index.nStatus & BLOCK_HAVE_DATA)) break;
+        auto future{m_chainman.m_thread_pool->Submit(
+            [&blockman = m_blockman, &consensus = m_chainman.GetConsensus(), &coins_db = m_coins_views->m_dbview,
+             pos = index.GetBlockPos(), hash = index.GetBlockHash()] {
+                return PrepareLookaheadBlock(blockman, consensus, coins_db, pos, hash);
+            })};
+        // The pool has no workers or is shutting down, so blocks are read when connected.
+        if (!future) break;
+        m_block_lookahead.emplace_back(&index, std::move(*future));
+    }
+}
+
+std::shared_ptr<const CBlock> Chainstate::TakeLookaheadBlock(const CBlockIndex& index)
+{
+    AssertLockHeld(cs_main);
+    if (m_block_lookahead.empty() || m_block_lookahead.front().pindex != &index) return nullptr;
+    auto block{m_block_lookahead.front().block.get()};
+    m_block_lookahead.pop_front();
+    return block;
+}
+
 /**
  * Return the tip of the chain with the most work in it, that isn't
  * known to be invalid (it's however far from certain to be valid).
@@ -3248,12 +3359,19 @@ bool Chainstate::ActivateBestChainStep(BlockValidationState& state, CBlockIndex&
         nHeight = nTargetHeight;
 
         // Connect new blocks.
-        for (CBlockIndex* pindexConnect : vpindexToConnect | std::views::reverse) {
+        std::ranges::reverse(vpindexToConnect);
+        for (size_t i{0}; i < vpindexToConnect.size(); ++i) {
+            CBlockIndex* pindexConnect{vpindexToConnect[i]};
+            // Prepare the next blocks while this one is being connected. The block
+            // passed in by the caller does not need to be read from disk.
+            auto upcoming{std::span{vpindexToConnect}.subspan(i)};
+            if (pblock && upcoming.back() == &index_most_work) upcoming = upcoming.first(upcoming.size() - 1);
+            ScheduleBlockLookahead(upcoming);
             if (!ConnectTip(state, pindexConnect, pindexConnect == &index_most_work ? pblock : std::shared_ptr<const CBlock>(), connected_blocks, disconnectpool)) {
                 if (state.IsInvalid()) {
                     // The block violates a consensus rule.
                     if (state.GetResult() != BlockValidationResult::BLOCK_MUTATED) {
-                        InvalidChainFound(vpindexToConnect.front());
+                        InvalidChainFound(vpindexToConnect.back());
                     }
                     state = BlockValidationState();
                     fInvalidFound = true;
@@ -5493,6 +5611,8 @@ bool Chainstate::ResizeCoinsCaches(size_t coinstip_size, size_t coinsdb_size)
     size_t old_coinstip_size = m_coinstip_cache_size_bytes;
     m_coinstip_cache_size_bytes = coinstip_size;
     m_coinsdb_cache_size_bytes = coinsdb_size;
+    // Lookahead tasks may be reading from the database that is about to be reopened.
+    ClearBlockLookahead();
     CoinsDB().ResizeCache(coinsdb_size);
 
     LogInfo("[%s] resized coinsdb cache to %.1f MiB",
@@ -5777,6 +5897,60 @@ static void SnapshotUTXOHashBreakpoint(const util::SignalInterrupt& interrupt)
     if (interrupt) throw StopHashingException();
 }
 
+//! Check a coin read from a snapshot. Returns a description of the problem if
+//! the coin is invalid, which is empty if nothing more specific is known.
+static std::optional<std::string> CheckSnapshotCoin(const COutPoint& outpoint, const Coin& coin, int base_height)
+{
+    if (coin.nHeight > base_height ||
+        outpoint.n >= std::numeric_limits<decltype(outpoint.n)>::max() // Avoid integer wrap-around in coinstats.cpp:ApplyHash
+    ) {
+        return "";
+    }
+    if (!MoneyRange(coin.out.nValue)) {
+        return " - bad tx out value";
+    }
+    return std::nullopt;
+}
+
+//! Check the hash of a chunk of a chunked snapshot and deserialize its coins.
+static util::Result<std::vector<std::pair<COutPoint, Coin>>> ReadSnapshotChunk(const node::SnapshotChunk& chunk, int base_height)
+{
+    if (Hash(chunk.data) != chunk.hash) {
+        return util::Error{Untranslated("Bad snapshot chunk hash")};
+    }
+    std::vector<std::pair<COutPoint, Coin>> coins;
+    // The count is untrusted, but bounded by the chunk size since every coin takes several bytes.
+    coins.reserve(std::min<uint64_t>(chunk.coins_count, chunk.data.size()));
+    SpanReader reader{chunk.data};
+    try {
+        while (!reader.empty()) {
+            Txid txid;
+            reader >> txid;
+            const uint64_t coins_per_txid{ReadCompactSize(reader)};
+            if (coins_per_txid > chunk.coins_count - coins.size()) {
+                return util::Error{Untranslated("Mismatch in coins count in snapshot chunk and actual chunk data")};
+            }
+            for (uint64_t i = 0; i < coins_per_txid; ++i) {
+                COutPoint outpoint;
+                Coin coin;
+                outpoint.n = static_cast<uint32_t>(ReadCompactSize(reader));
+                outpoint.hash = txid;
+                reader >> coin;
+                if (auto error{CheckSnapshotCoin(outpoint, coin, base_height)}) {
+                    return util::Error{Untranslated(strprintf("Bad snapshot data in chunk%s", *error))};
+                }
+                coins.emplace_back(outpoint, std::move(coin));
+            }
+        }
+    } catch (const std::ios_base::failure&) {
+        return util::Error{Untranslated("Bad snapshot format in chunk")};
+    }
+    if (coins.size() != chunk.coins_count) {
+        return util::Error{Untranslated("Mismatch in coins count in snapshot chunk and actual chunk data")};
+    }
+    return coins;
+}
+
 util::Result<void> ChainstateManager::PopulateAndValidateSnapshot(
     Chainstate& snapshot_chainstate,
     AutoFile& coins_file,
@@ -5785,6 +5959,7 @@ util::Result<void> ChainstateManager::PopulateAndValidateSnapshot(
     // It's okay to release cs_main before we're done using `coins_cache` because we know
     // that nothing else will be referencing the newly created snapshot_chainstate yet.
     CCoinsViewCache& coins_cache = *WITH_LOCK(::cs_main, return &snapshot_chainstate.CoinsTip());
+    CCoinsViewDB& coins_db = WITH_LOCK(::cs_main, return snapshot_chainstate.CoinsDB());
 
     uint256 base_blockhash = metadata.m_base_blockhash;
 
@@ -5820,71 +5995,120 @@ util::Result<void> ChainstateManager::PopulateAndValidateSnapshot(
     LogInfo("[snapshot] loading %d coins from snapshot %s", coins_left, base_blockhash.ToString());
     int64_t coins_processed{0};
 
-    while (coins_left > 0) {
-        try {
-            Txid txid;
-            coins_file >> txid;
-            size_t coins_per_txid{0};
-            coins_per_txid = ReadCompactSize(coins_file);
+    // Snapshots are written in key order, which is what bulk loading benefits from.
+    coins_db.StartBulkLoad();
 
-            if (coins_per_txid > coins_left) {
-                return util::Error{Untranslated("Mismatch in coins count in snapshot metadata and actual snapshot data")};
-            }
+    // Add a coin that passed the checks in CheckSnapshotCoin to the cache. Returns
+    // false if loading should be aborted because an interrupt was requested.
+    const auto add_coin{[&](COutPoint&& outpoint, Coin&& coin) {
+        coins_cache.EmplaceCoinInternalDANGER(std::move(outpoint), std::move(coin));
 
-            for (size_t i = 0; i < coins_per_txid; i++) {
-                COutPoint outpoint;
-                Coin coin;
-                outpoint.n = static_cast<uint32_t>(ReadCompactSize(coins_file));
-                outpoint.hash = txid;
-                coins_file >> coin;
-                if (coin.nHeight > base_height ||
-                    outpoint.n >= std::numeric_limits<decltype(outpoint.n)>::max() // Avoid integer wrap-around in coinstats.cpp:ApplyHash
-                ) {
-                    return util::Error{Untranslated(strprintf("Bad snapshot data after deserializing %d coins",
-                              coins_count - coins_left))};
-                }
-                if (!MoneyRange(coin.out.nValue)) {
-                    return util::Error{Untranslated(strprintf("Bad snapshot data after deserializing %d coins - bad tx out value",
-                              coins_count - coins_left))};
-                }
-                coins_cache.EmplaceCoinInternalDANGER(outpoint, std::move(coin));
+        --coins_left;
+        ++coins_processed;
+
+        if (coins_processed % 1000000 == 0) {
+            LogInfo("[snapshot] %d coins loaded (%.2f%%, %.2f MB)",
+                coins_processed,
+                static_cast<float>(coins_processed) * 100 / static_cast<float>(coins_count),
+                coins_cache.DynamicMemoryUsage() / (1000 * 1000));
+        }
+
+        // Batch write and flush (if we need to) every so often.
+        //
+        // If our average Coin size is roughly 41 bytes, checking every 120,000 coins
+        // means <5MB of memory imprecision.
+        if (coins_processed % 120000 == 0) {
+            if (m_interrupt) return false;
+
+            const auto snapshot_cache_state = WITH_LOCK(::cs_main,
+                return snapshot_chainstate.GetCoinsCacheSizeState());
+
+            if (snapshot_cache_state >= CoinsCacheSizeState::CRITICAL) {
+                // This is a hack - we don't know what the actual best block is, but that
+                // doesn't matter for the purposes of flushing the cache here. We'll set this
+                // to its correct value (`base_blockhash`) below after the coins are loaded.
+                coins_cache.SetBestBlock(GetRandHash());
+
+                // No need to acquire cs_main since this chainstate isn't being used yet.
+                FlushSnapshotToDisk(coins_cache, /*snapshot_loaded=*/false);
+            }
+        }
+        return true;
+    }};
 
-                --coins_left;
-                ++coins_processed;
+    if (!metadata.IsChunked()) {
+        while (coins_left > 0) {
+            try {
+                Txid txid;
+                coins_file >> txid;
+                size_t coins_per_txid{0};
+                coins_per_txid = ReadCompactSize(coins_file);
 
-                if (coins_processed % 1000000 == 0) {
-                    LogInfo("[snapshot] %d coins loaded (%.2f%%, %.2f MB)",
-                        coins_processed,
-                        static_cast<float>(coins_processed) * 100 / static_cast<float>(coins_count),
-                        coins_cache.DynamicMemoryUsage() / (1000 * 1000));
+                if (coins_per_txid > coins_left) {
+                    return util::Error{Untranslated("Mismatch in coins count in snapshot metadata and actual snapshot data")};
                 }
 
-                // Batch write and flush (if we need to) every so often.
-                //
-                // If our average Coin size is roughly 41 bytes, checking every 120,000 coins
-                // means <5MB of memory imprecision.
-                if (coins_processed % 120000 == 0) {
-                    if (m_interrupt) {
+                for (size_t i = 0; i < coins_per_txid; i++) {
+                    COutPoint outpoint;
+                    Coin coin;
+                    outpoint.n = static_cast<uint32_t>(ReadCompactSize(coins_file));
+                    outpoint.hash = txid;
+                    coins_file >> coin;
+                    if (auto error{CheckSnapshotCoin(outpoint, coin, base_height)}) {
+                        return util::Error{Untranslated(strprintf("Bad snapshot data after deserializing %d coins%s",
+                                  coins_count - coins_left, *error))};
+                    }
+                    if (!add_coin(std::move(outpoint), std::move(coin))) {
                         return util::Error{Untranslated("Aborting after an interrupt was requested")};
                     }
+                }
+            } catch (const std::ios_base::failure&) {
+                return util::Error{Untranslated(strprintf("Bad snapshot format or truncated snapshot after deserializing %d coins",
+                          coins_processed))};
+            }
+        }
+    } else {
+        // Chunks are read from the file in order and checked and deserialized on
+        // the validation thread pool, while the coins of earlier chunks are added
+        // to the cache here. Without workers, chunks are processed one by one.
+        using ChunkResult = util::Result<std::vector<std::pair<COutPoint, Coin>>>;
+        const size_t max_pending_chunks{std::max<size_t>(2 * m_thread_pool->WorkersCount(), 1)};
+        std::deque<std::future<ChunkResult>> pending_chunks;
+        uint64_t coins_read{0};
+        while (coins_read < coins_count || !pending_chunks.empty()) {
+            while (coins_read < coins_count && pending_chunks.size() < max_pending_chunks) {
+                auto chunk{std::make_shared<node::SnapshotChunk>()};
+                try {
+                    coins_file >> *chunk;
+                } catch (const std::ios_base::failure&) {
+                    return util::Error{Untranslated(strprintf("Bad snapshot format or truncated snapshot after deserializing %d coins",
+                              coins_processed))};
+                }
+                if (chunk->coins_count == 0 || chunk->coins_count > coins_count - coins_read) {
+                    return util::Error{Untranslated("Mismatch in coins count in snapshot metadata and actual snapshot data")};
+                }
+                coins_read += chunk->coins_count;
 
-                    const auto snapshot_cache_state = WITH_LOCK(::cs_main,
-                        return snapshot_chainstate.GetCoinsCacheSizeState());
-
-                    if (snapshot_cache_state >= CoinsCacheSizeState::CRITICAL) {
-                        // This is a hack - we don't know what the actual best block is, but that
-                        // doesn't matter for the purposes of flushing the cache here. We'll set this
-                        // to its correct value (`base_blockhash`) below after the coins are loaded.
-                        coins_cache.SetBestBlock(GetRandHash());
+                auto future{m_thread_pool->Submit([chunk, base_height] { return ReadSnapshotChunk(*chunk, base_height); })};
+                if (!future) {
+                    std::promise<ChunkResult> result;
+                    result.set_value(ReadSnapshotChunk(*chunk, base_height));
+                    future = result.get_future();
+                }
+                pending_chunks.push_back(std::move(*future));
+            }
 
-                        // No need to acquire cs_main since this chainstate isn't being used yet.
-                        FlushSnapshotToDisk(coins_cache, /*snapshot_loaded=*/false);
-                    }
+            ChunkResult coins{pending_chunks.front().get()};
+            pending_chunks.pop_front();
+            if (!coins) {
+                return util::Error{Untranslated(strprintf("%s after deserializing %d coins",
+                          util::ErrorString(coins).original, coins_processed))};
+            }
+            for (auto& [outpoint, coin] : *coins) {
+                if (!add_coin(std::move(outpoint), std::move(coin))) {
+                    return util::Error{Untranslated("Aborting after an interrupt was requested")};
                 }
             }
-        } catch (const std::ios_base::failure&) {
-            return util::Error{Untranslated(strprintf("Bad snapshot format or truncated snapshot after deserializing %d coins",
-                      coins_processed))};
         }
     }
 
@@ -5913,6 +6137,11 @@ util::Result<void> ChainstateManager::PopulateAndValidateSnapshot(
         coins_cache.DynamicMemoryUsage() / (1000 * 1000),
         base_blockhash.ToString());
 
+    // Write the remaining coins as part of the bulk load as well, so that the
+    // final flush only records the best block.
+    FlushSnapshotToDisk(coins_cache, /*snapshot_loaded=*/false);
+    coins_db.FinishBulkLoad();
+
     // No need to acquire cs_main since this chainstate isn't being used yet.
     FlushSnapshotToDisk(coins_cache, /*snapshot_loaded=*/true);
 
@@ -6158,8 +6387,23 @@ static ChainstateManager::Options&& Flatten(ChainstateManager::Options&& opts)
     return std::move(opts);
 }
 
+static std::shared_ptr<ThreadPool> MakeValidationThreadPool(int script_threads, int32_t prevoutfetch_threads)
+{
+    auto thread_pool{std::make_shared<ThreadPool>("validation")};
+    if (prevoutfetch_threads > 0) {
+        LogInfo("Block input prevout fetching uses %d additional threads", prevoutfetch_threads);
+    }
+    if (const int num_workers{std::max(script_threads, prevoutfetch_threads)}; num_workers > 0) {
+        thread_pool->Start(num_workers);
+        LogInfo("Validation thread pool uses %d threads", num_workers);
+    }
+    return thread_pool;
+}
+
 ChainstateManager::ChainstateManager(const util::SignalInterrupt& interrupt, Options options, node::BlockManager::Options blockman_options)
-    : m_script_check_queue{/*batch_size=*/128, std::clamp(options.worker_threads_num, 0, MAX_SCRIPTCHECK_THREADS)},
+    : m_thread_pool{MakeValidationThreadPool(std::clamp(options.worker_threads_num, 0, MAX_SCRIPTCHECK_THREADS),
+                                             std::clamp(options.prevoutfetch_threads_num, 0, MAX_PREVOUTFETCH_THREADS))},
+      m_script_check_queue{/*batch_size=*/128, std::clamp(options.worker_threads_num, 0, MAX_SCRIPTCHECK_THREADS), m_thread_pool},
       m_interrupt{interrupt},
       m_options{Flatten(std::move(options))},
       m_blockman{interrupt, std::move(blockman_options)},
@@ -6230,6 +6474,7 @@ util::Result<void> Chainstate::InvalidateCoinsDBOnDisk()
     assert(m_from_snapshot_blockhash);
 
     // Coins views no longer usable.
+    ClearBlockLookahead();
     m_coins_views.reset();
 
     const fs::path db_path{StoragePath()};
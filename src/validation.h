@@ -22,6 +22,7 @@
 #include <policy/feerate.h>
 #include <policy/packages.h>
 #include <policy/policy.h>
+#include <pubkey.h>
 #include <script/script_error.h>
 #include <script/sigcache.h>
 #include <script/verify_flags.h>
@@ -41,6 +42,8 @@
 #include <algorithm>
 #include <atomic>
 #include <cstdint>
+#include <deque>
+#include <future>
 #include <map>
 #include <memory>
 #include <optional>
@@ -92,6 +95,9 @@ static constexpr int MAX_SCRIPTCHECK_THREADS{15};
 /** Maximum number of dedicated threads allowed for prefetching block input prevouts */
 static constexpr int32_t MAX_PREVOUTFETCH_THREADS{16};
 
+/** Maximum number of blocks allowed to be prepared ahead of the block being connected */
+static constexpr int32_t MAX_BLOCK_LOOKAHEAD{16};
+
 /** Current sync state passed to tip changed callbacks. */
 enum class SynchronizationState {
     INIT_REINDEX,
@@ -349,7 +355,12 @@ private:
     PrecomputedTransactionData *txdata;
     SignatureCache* m_signature_cache;
 
+    std::optional<std::pair<ScriptError, std::string>> Check(BatchSchnorrVerifier* batch);
+
 public:
+    //! Deferred Schnorr signatures are collected here and verified once per group of checks (see CCheckQueue).
+    using Batch = BatchSchnorrVerifier;
+
     CScriptCheck(const CTxOut& outIn, const CTransaction& txToIn, SignatureCache& signature_cache, unsigned int nInIn, script_verify_flags flags, bool cacheIn, PrecomputedTransactionData* txdataIn) :
         m_tx_out(outIn), ptxTo(&txToIn), nIn(nInIn), m_flags(flags), cacheStore(cacheIn), txdata(txdataIn), m_signature_cache(&signature_cache) { }
 
@@ -358,7 +369,9 @@ public:
     CScriptCheck(CScriptCheck&&) = default;
     CScriptCheck& operator=(CScriptCheck&&) = default;
 
-    std::optional<std::pair<ScriptError, std::string>> operator()();
+    std::optional<std::pair<ScriptError, std::string>> operator()() { return Check(nullptr); }
+    /** Run the check, deferring Schnorr signatures not found in the signature cache to batch. */
+    std::optional<std::pair<ScriptError, std::string>> operator()(Batch& batch) { return Check(&batch); }
 };
 
 // CScriptCheck is used a lot in std::vector, make sure that's efficient
@@ -505,8 +518,9 @@ public:
     //! All arguments forwarded onto CCoinsViewDB.
     CoinsViews(DBParams db_params, CoinsViewOptions options);
 
-    //! Initialize the CCoinsViewCache member.
-    void InitCache(int32_t prevoutfetch_threads) EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
+    //! Initialize the CCoinsViewCache member. Block input prevouts are prefetched on
+    //! thread_pool by up to prevoutfetch_threads concurrent tasks.
+    void InitCache(std::shared_ptr<ThreadPool> thread_pool, int32_t prevoutfetch_threads) EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
 };
 
 enum class CoinsCacheSizeState
@@ -567,6 +581,23 @@ protected:
     //! Manages the UTXO set, which is a reflection of the contents of `m_chain`.
     std::unique_ptr<CoinsViews> m_coins_views;
 
+    //! A block that is read from disk, checked and has its inputs warmed up on the
+    //! validation thread pool while earlier blocks are being connected.
+    struct LookaheadBlock {
+        const CBlockIndex* pindex;
+        //! Resolves to nullptr if the block could not be read.
+        std::future<std::shared_ptr<const CBlock>> block;
+
+        LookaheadBlock(const CBlockIndex* index, std::future<std::shared_ptr<const CBlock>> future)
+            : pindex{index}, block{std::move(future)} {}
+        //! The task references m_blockman and m_coins_views, so it must not outlive them.
+        ~LookaheadBlock() { if (block.valid()) block.wait(); }
+    };
+
+    //! Upcoming blocks on the path to the most-work chain, in ascending height order.
+    //! Declared after m_coins_views so that pending tasks are waited for first.
+    std::deque<LookaheadBlock> m_block_lookahead GUARDED_BY(::cs_main);
+
     //! Cached result of LookupBlockIndex(*m_from_snapshot_blockhash)
     mutable const CBlockIndex* m_cached_snapshot_base GUARDED_BY(::cs_main){nullptr};
 
@@ -685,7 +716,9 @@ public:
      */
     std::set<CBlockIndex*, node::CBlockIndexWorkComparator> setBlockIndexCandidates;
 
-    //! @returns A reference to the in-memory cache of the UTXO set.
+    //! @returns A reference to the in-memory cache of the UTXO set. Its
+    //! PeekCoin() and GetBestBlock() may be called without holding cs_main,
+    //! since the cache is only replaced when the chainstate is loaded or reset.
     CCoinsViewCache& CoinsTip() EXCLUSIVE_LOCKS_REQUIRED(::cs_main)
     {
         AssertLockHeld(::cs_main);
@@ -700,6 +733,15 @@ public:
         return Assert(m_coins_views)->m_dbview;
     }
 
+    //! @returns A reference to the view blocks are connected through, which
+    //!     prefetches their inputs.
+    CoinsViewOverlay& ConnectBlockView() EXCLUSIVE_LOCKS_REQUIRED(::cs_main)
+    {
+        AssertLockHeld(::cs_main);
+        Assert(m_coins_views);
+        return *Assert(m_coins_views->m_connect_block_view);
+    }
+
     //! @returns A pointer to the mempool.
     CTxMemPool* GetMempool()
     {
@@ -715,7 +757,11 @@ public:
     }
 
     //! Destructs all objects related to accessing the UTXO set.
-    void ResetCoinsViews() { m_coins_views.reset(); }
+    void ResetCoinsViews() EXCLUSIVE_LOCKS_REQUIRED(::cs_main)
+    {
+        ClearBlockLookahead();
+        m_coins_views.reset();
+    }
 
     //! The cache size of the on-disk coins view.
     size_t m_coinsdb_cache_size_bytes{0};
@@ -863,6 +909,19 @@ protected:
         std::vector<ConnectedBlock>& connected_blocks,
         DisconnectedBlockTransactions& disconnectpool) EXCLUSIVE_LOCKS_REQUIRED(cs_main, m_mempool->cs);
 
+    /**
+     * Start preparing the blocks that will be connected after the current one on the
+     * validation thread pool, and drop lookahead blocks that are no longer upcoming.
+     *
+     * @param[in] blocks The blocks to connect in ascending height order, starting with the one
+     *                   about to be connected.
+     */
+    void ScheduleBlockLookahead(std::span<CBlockIndex* const> blocks) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
+    //! Return the block for index if it was prepared by the lookahead, nullptr otherwise.
+    std::shared_ptr<const CBlock> TakeLookaheadBlock(const CBlockIndex& index) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
+    //! Wait for and drop all lookahead blocks.
+    void ClearBlockLookahead() EXCLUSIVE_LOCKS_REQUIRED(cs_main) { m_block_lookahead.clear(); }
+
     void InvalidBlockFound(CBlockIndex* pindex, const BlockValidationState& state) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
     CBlockIndex* FindMostWorkChain() EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 
@@ -979,6 +1038,10 @@ private:
     /** Most recent headers presync progress update, for rate-limiting. */
     MockableSteadyClock::time_point m_last_presync_update GUARDED_BY(GetMutex()){};
 
+    //! Work-stealing pool shared by script verification and block input prevout
+    //! fetching, so that both draw from one set of threads instead of oversubscribing cores.
+    std::shared_ptr<ThreadPool> m_thread_pool;
+
     //! A queue for script verifications that have to be performed by worker threads.
     CCheckQueue<CScriptCheck> m_script_check_queue;
 
@@ -1378,6 +1441,7 @@ public:
     std::optional<int> BlocksAheadOfTip() const LOCKS_EXCLUDED(::cs_main);
 
     CCheckQueue<CScriptCheck>& GetCheckQueue() { return m_script_check_queue; }
+    const std::shared_ptr<ThreadPool>& GetThreadPool() const { return m_thread_pool; }
 
     ~ChainstateManager();
 
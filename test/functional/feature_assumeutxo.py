@@ -77,7 +77,7 @@ class AssumeutxoTest(BitcoinTestFramework):
         self.add_nodes(4)
         self.start_nodes(extra_args=self.extra_args)
 
-    def test_invalid_snapshot_scenarios(self, valid_snapshot_path):
+    def test_invalid_snapshot_scenarios(self, valid_snapshot_path, valid_chunked_snapshot_path):
         self.log.info("Test different scenarios of loading invalid snapshot files")
         with open(valid_snapshot_path, 'rb') as f:
             valid_snapshot_contents = f.read()
@@ -95,7 +95,7 @@ class AssumeutxoTest(BitcoinTestFramework):
         assert_raises_rpc_error(parsing_error_code, "Unable to parse metadata: Invalid UTXO set snapshot magic bytes. Please check if this is indeed a snapshot file or if you are using an outdated snapshot format.", node.loadtxoutset, bad_snapshot_path)
 
         self.log.info("  - snapshot file with unsupported version")
-        for version in [0, 1, 3]:
+        for version in [0, 1, 4]:
             with open(bad_snapshot_path, 'wb') as f:
                 f.write(valid_snapshot_contents[:5] + version.to_bytes(2, "little") + valid_snapshot_contents[7:])
             assert_raises_rpc_error(parsing_error_code, f"Unable to parse metadata: Version of snapshot {version} does not match any of the supported versions.", node.loadtxoutset, bad_snapshot_path)
@@ -166,6 +166,18 @@ class AssumeutxoTest(BitcoinTestFramework):
             msg = custom_message if custom_message is not None else f"Bad snapshot content hash: expected 106b2c56233e378a824cf0d5ff2be42ed32c72f1605c9be288d00942908a40ac, got {wrong_hash}."
             expected_error(msg)
 
+        self.log.info("  - chunked snapshot file with corrupted or truncated chunk")
+        with open(valid_chunked_snapshot_path, 'rb') as f:
+            valid_chunked_contents = f.read()
+        # Prior to offset: metadata, chunk coins count and chunk size
+        offset = 5 + 2 + 4 + 32 + 8 + 3 + 3 + 10
+        with open(bad_snapshot_path, 'wb') as f:
+            f.write(valid_chunked_contents[:offset] + bytes([valid_chunked_contents[offset] ^ 1]) + valid_chunked_contents[offset + 1:])
+        expected_error("Bad snapshot chunk hash after deserializing 0 coins")
+        with open(bad_snapshot_path, 'wb') as f:
+            f.write(valid_chunked_contents[:-1])
+        expected_error("Bad snapshot format or truncated snapshot after deserializing 0 coins")
+
     def test_headers_not_synced(self, valid_snapshot_path):
         for node in self.nodes[1:]:
             msg = "Unable to load UTXO snapshot: The base block header (0c552ced4721c249a389eb9b08cb8da261cd46f0e7b5f9d064d48f3113406853) must appear in the headers chain. Make sure all headers are syncing, and call loadtxoutset again."
@@ -507,12 +519,17 @@ class AssumeutxoTest(BitcoinTestFramework):
         dump_output5 = n0.dumptxoutset('utxos5.dat', rollback=prev_snap_hash)
         assert_equal(sha256sum_file(dump_output4['path']), sha256sum_file(dump_output5['path']))
 
+        # Chunked format
+        dump_output_chunked = n0.dumptxoutset(path='utxos_chunked.dat', rollback=SNAPSHOT_BASE_HEIGHT, chunked=True)
+        check_dump_output(dump_output_chunked)
+        assert_equal(dump_output_chunked['coins_written'], dump_output['coins_written'])
+
         # Ensure n0 is back at the tip
         assert_equal(n0.getblockchaininfo()["blocks"], FINAL_HEIGHT)
 
         self.test_snapshot_with_less_work(dump_output['path'])
         self.test_invalid_mempool_state(dump_output['path'])
-        self.test_invalid_snapshot_scenarios(dump_output['path'])
+        self.test_invalid_snapshot_scenarios(dump_output['path'], dump_output_chunked['path'])
         self.test_invalid_chainstate_scenarios()
         self.test_invalid_file_path()
         self.test_snapshot_block_invalidated(dump_output['path'])
@@ -723,8 +740,8 @@ class AssumeutxoTest(BitcoinTestFramework):
         assert_equal(n2.getblockcount(), START_HEIGHT)
         assert 'NETWORK' in n2.getnetworkinfo()['localservicesnames']  # sanity check
 
-        self.log.info(f"Loading snapshot into third node from {dump_output['path']}")
-        loaded = n2.loadtxoutset(dump_output['path'])
+        self.log.info(f"Loading chunked snapshot into third node from {dump_output_chunked['path']}")
+        loaded = n2.loadtxoutset(dump_output_chunked['path'])
         assert_equal(loaded['coins_loaded'], SNAPSHOT_BASE_HEIGHT)
         assert_equal(loaded['base_height'], SNAPSHOT_BASE_HEIGHT)
 
@@ -740,7 +757,7 @@ class AssumeutxoTest(BitcoinTestFramework):
             for i in range(1, 300):
                 block = n0.getblock(n0.getblockhash(i), 0)
                 n2.submitheader(block)
-            loaded = n2.loadtxoutset(dump_output['path'])
+            loaded = n2.loadtxoutset(dump_output_chunked['path'])
             assert_equal(loaded['coins_loaded'], SNAPSHOT_BASE_HEIGHT)
             assert_equal(loaded['base_height'], SNAPSHOT_BASE_HEIGHT)
 
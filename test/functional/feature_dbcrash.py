@@ -48,10 +48,14 @@ class ChainstateWriteCrashTest(BitcoinTestFramework):
         self.num_nodes = 4
         self.rpc_timeout = 480
 
-        # Set -maxmempool=0 to turn off mempool memory sharing with dbcache
+        # Set -maxmempool=0 to turn off mempool memory sharing with dbcache.
+        # Set -dbbackgroundflush=0 so that simulated crashes happen inside the
+        # submitblock call that triggered the flush, which the restart logic
+        # below relies on to know which block the node should recover to.
         self.base_args = [
             "-maxmempool=0",
             "-dbbatchsize=200000",
+            "-dbbackgroundflush=0",
         ]
 
         # Set different crash ratios and cache sizes.  Note that not all of
@@ -7,6 +7,8 @@ from collections import defaultdict
 
 from test_framework.messages import (
     CInv,
+    MSG_BLOCK,
+    MSG_WITNESS_FLAG,
     msg_getdata,
 )
 from test_framework.p2p import P2PInterface
@@ -17,9 +19,11 @@ class P2PStoreBlock(P2PInterface):
     def __init__(self):
         super().__init__()
         self.blocks = defaultdict(int)
+        self.block_order = []
 
     def on_block(self, message):
         self.blocks[message.block.hash_int] += 1
+        self.block_order.append(message.block.hash_int)
 
 
 class GetdataTest(BitcoinTestFramework):
@@ -43,6 +47,15 @@ class GetdataTest(BitcoinTestFramework):
         p2p_block_store.send_and_ping(good_getdata)
         p2p_block_store.wait_until(lambda: p2p_block_store.blocks[best_block] == 1)
 
+        self.log.info("test that blocks read in the background are served in the requested order")
+        self.restart_node(0, extra_args=["-asyncblockreads"])
+        p2p_block_store = self.nodes[0].add_p2p_connection(P2PStoreBlock())
+        old_blocks = [int(self.nodes[0].getblockhash(height), 16) for height in range(1, 11)]
+        getdata = msg_getdata([CInv(t=MSG_BLOCK | MSG_WITNESS_FLAG, h=block) for block in old_blocks])
+        p2p_block_store.send_and_ping(getdata)
+        p2p_block_store.wait_until(lambda: len(p2p_block_store.block_order) == len(old_blocks))
+        assert p2p_block_store.block_order == old_blocks
+
 
 if __name__ == '__main__':
     GetdataTest(__file__).main()
@@ -100,6 +100,8 @@ class BlockchainTest(BitcoinTestFramework):
         self._test_waitforblock() # also tests waitfornewblock
         self._test_waitforblockheight()
         self._test_getblock()
+        self._test_getblockcacheinfo()
+        self._test_getcoinscacheinfo()
         self._test_getdeploymentinfo()
         self._test_verificationprogress()
         self._test_y2106()
@@ -765,6 +767,43 @@ class BlockchainTest(BitcoinTestFramework):
         assert_raises_rpc_error(-1, "Block not found on disk", node.getblock, blockhash)
         move_block_file('blk00000.dat.bak', 'blk00000.dat')
 
+    def _test_getblockcacheinfo(self):
+        self.log.info("Test getblockcacheinfo")
+        node = self.nodes[0]
+        blockhash = node.getbestblockhash()
+
+        node.getblock(blockhash, 3)
+        before = node.getblockcacheinfo()
+        assert_greater_than(before["blocks"], 0)
+        assert_greater_than(before["undos"], 0)
+        assert_greater_than(before["usage"], 0)
+        assert_equal(before["max_usage"], 32 << 20)
+
+        # Both the block and its undo data are served from the cache now
+        node.getblock(blockhash, 3)
+        after = node.getblockcacheinfo()
+        assert_equal(after["block_hits"], before["block_hits"] + 1)
+        assert_equal(after["undo_hits"], before["undo_hits"] + 1)
+        assert_equal(after["block_misses"], before["block_misses"])
+        assert_equal(after["undo_misses"], before["undo_misses"])
+
+    def _test_getcoinscacheinfo(self):
+        self.log.info("Test getcoinscacheinfo")
+        node = self.nodes[0]
+
+        before = node.getcoinscacheinfo()
+        db = before["db"]
+        assert_equal(len(db["read_latency"]), 16)
+        assert_equal(sum(db["read_latency"]), db["reads"])
+        assert_greater_than_or_equal(db["reads"], db["reads_found"])
+        assert "leveldb_stats" in db
+
+        # A coin lookup is counted as either a cache hit or a miss
+        coinbase_txid = node.getblock(node.getblockhash(1))["tx"][0]
+        node.gettxout(coinbase_txid, 0)
+        after = node.getcoinscacheinfo()
+        assert_equal(after["hits"] + after["misses"], before["hits"] + before["misses"] + 1)
+
 
 if __name__ == '__main__':
     BlockchainTest(__file__).main()
@@ -79,6 +79,14 @@ class DumptxoutsetTest(BitcoinTestFramework):
             out['txoutset_hash'], '771d773b5c27b6f35f598ce764652a2cf28fbc268341eb1827844e416c629c7d')
         assert_equal(out['nchaintx'], 101)
 
+        self.log.info("Test that dumptxoutset can write the chunked format")
+        out_chunked = node.dumptxoutset(path='txoutset_chunked.dat', type="latest", chunked=True)
+        assert_equal(out_chunked['coins_written'], out['coins_written'])
+        assert_equal(out_chunked['txoutset_hash'], out['txoutset_hash'])
+        with open(out_chunked['path'], 'rb') as f:
+            # Version follows the magic bytes
+            assert_equal(f.read(7)[5:], (3).to_bytes(2, 'little'))
+
         # Specifying a path to an existing or invalid file will fail.
         assert_raises_rpc_error(
             -8, '{} already exists'.format(FILENAME),  node.dumptxoutset, FILENAME, "latest")